@@ -0,0 +1,133 @@
+// Benchmark de throughput dos crossovers em função de n
+// Compara o OX antigo (std::find por gene, O(n²)) com a versão atual O(n)
+#include "src/tsp.hpp"
+#include "src/ga.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Implementação original do OX, mantida apenas como referência de desempenho
+static Rota crossoverOrdenadoLegado(const Rota &parente1, const Rota &parente2, std::mt19937 &rng)
+{
+    int n = parente1.size();
+    std::uniform_int_distribution<int> dist(0, n - 1);
+
+    int start = dist(rng);
+    int end = dist(rng);
+    if (start > end)
+        std::swap(start, end);
+
+    Rota child(n, -1);
+    for (int i = start; i <= end; ++i)
+    {
+        child[i] = parente1[i];
+    }
+
+    int child_pos = (end + 1) % n;
+    for (int i = 0; i < n; ++i)
+    {
+        int pto = parente2[(end + 1 + i) % n];
+        if (std::find(child.begin(), child.end(), pto) == child.end())
+        {
+            child[child_pos] = pto;
+            child_pos = (child_pos + 1) % n;
+        }
+    }
+    return child;
+}
+
+// Executa fn até acumular ~tempo_min segundos e devolve crossovers por segundo
+template <typename Fn>
+static double medirThroughput(Fn fn, double tempo_min = 0.25)
+{
+    using clock = std::chrono::steady_clock;
+    long iteracoes = 0;
+    auto inicio = clock::now();
+    double decorrido = 0.0;
+    while (decorrido < tempo_min)
+    {
+        for (int k = 0; k < 8; ++k)
+            fn();
+        iteracoes += 8;
+        decorrido = std::chrono::duration<double>(clock::now() - inicio).count();
+    }
+    return iteracoes / decorrido;
+}
+
+int main(int argc, char *argv[])
+{
+    int n_max = argc > 1 ? std::atoi(argv[1]) : 10000;
+
+    std::cout << std::setw(8) << "n"
+              << std::setw(16) << "ox_legado/s"
+              << std::setw(16) << "ox/s"
+              << std::setw(16) << "pmx/s"
+              << std::setw(16) << "erx/s"
+              << std::setw(16) << "eax/s"
+              << std::setw(10) << "ganho_ox" << "\n";
+
+    for (int n : {100, 500, 1000, 2000, 5000, 10000, 20000})
+    {
+        if (n > n_max)
+            break;
+
+        InstanciaTSP tsp;
+        tsp.configurarDistancias(BackendDistancia::DIRETA);
+        tsp.generateUniform(n, 42);
+
+        std::mt19937 rng(7);
+        GeradorPhilox gerador(7);
+        Rota p1 = tsp.randomRota(gerador);
+        Rota p2 = tsp.randomRota(gerador);
+
+        GAConfig cfg;
+        GeneticAlgorithm<uint32_t> ga(tsp, cfg);
+        Rota child(n);
+        ListaVizinhos vizinhos = tsp.listasVizinhos(cfg.vizinhos_busca);
+        CruzamentoERX erx;
+        CruzamentoEAX eax(tsp, vizinhos);
+
+        // O legado é quadrático: usa janela menor para n grande
+        double legado = medirThroughput([&]
+                                        { child = crossoverOrdenadoLegado(p1, p2, rng); },
+                                        n > 5000 ? 1.0 : 0.25);
+        double ox = medirThroughput([&]
+                                    { ga.crossoverOrdenado(p1, p2, child); });
+        if (!tsp.rotaValida(child))
+        {
+            std::cerr << "OX gerou rota inválida para n=" << n << "\n";
+            return 1;
+        }
+        double pmx = medirThroughput([&]
+                                     { ga.crossoverParcialmenteMapeado(p1, p2, child); });
+        if (!tsp.rotaValida(child))
+        {
+            std::cerr << "PMX gerou rota inválida para n=" << n << "\n";
+            return 1;
+        }
+        double erx_s = medirThroughput([&]
+                                       { erx.cruzar(p1.data(), p2.data(), child.data(), n, gerador); });
+        if (!tsp.rotaValida(child))
+        {
+            std::cerr << "ERX gerou rota inválida para n=" << n << "\n";
+            return 1;
+        }
+        double eax_s = medirThroughput([&]
+                                       { eax.cruzar(p1.data(), p2.data(), child.data(), n, gerador); });
+        if (!tsp.rotaValida(child))
+        {
+            std::cerr << "EAX gerou rota inválida para n=" << n << "\n";
+            return 1;
+        }
+
+        std::cout << std::setw(8) << n
+                  << std::setw(16) << std::fixed << std::setprecision(0) << legado
+                  << std::setw(16) << ox
+                  << std::setw(16) << pmx
+                  << std::setw(16) << erx_s
+                  << std::setw(16) << eax_s
+                  << std::setw(9) << std::setprecision(1) << ox / legado << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,471 @@
+// Microbenchmarks dos kernels do GA, parametrizados por n e tamanho da população
+// Saída em tabela no terminal e, com --json, num arquivo JSON para comparar
+// execuções (ex.: antes/depois de uma mudança de desempenho)
+//
+// Uso: tsp_ga_bench [--n 100,1000,10000] [--pop 100,1000] [--tempo 0.2]
+//                   [--filtro texto] [--json arquivo.json]
+#include "src/tsp.hpp"
+#include "src/ga.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct ResultadoBench
+{
+    std::string nome;
+    int n;
+    int pop; // 0 = não depende da população
+    long iteracoes;
+    double ns_por_op;
+};
+
+struct OpcoesBench
+{
+    std::vector<int> ns{100, 1000, 10000};
+    std::vector<int> pops{100, 1000};
+    double tempo_min = 0.2;
+    std::string filtro;
+    std::string json;
+};
+
+static std::vector<int> lerLista(const char *texto)
+{
+    std::vector<int> valores;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+            valores.push_back(std::atoi(item.c_str()));
+    }
+    return valores;
+}
+
+// Resultado acumulado para impedir que o compilador descarte os kernels
+static volatile double sumidouro = 0.0;
+
+class Bancada
+{
+private:
+    OpcoesBench opcoes;
+    std::vector<ResultadoBench> resultados;
+    int falhas = 0; // kernels cuja saída não passou na verificação
+
+public:
+    explicit Bancada(const OpcoesBench &o) : opcoes(o) {}
+
+    bool ativo(const std::string &nome) const
+    {
+        return opcoes.filtro.empty() || nome.find(opcoes.filtro) != std::string::npos;
+    }
+
+    // Aquece uma vez e executa fn em lotes até acumular tempo_min segundos
+    template <typename Fn>
+    void medir(const std::string &nome, int n, int pop, Fn fn)
+    {
+        if (!ativo(nome))
+            return;
+        using clock = std::chrono::steady_clock;
+        fn();
+        long iteracoes = 0;
+        long lote = 1;
+        auto inicio = clock::now();
+        double decorrido = 0.0;
+        while (decorrido < opcoes.tempo_min)
+        {
+            for (long k = 0; k < lote; ++k)
+                fn();
+            iteracoes += lote;
+            decorrido = std::chrono::duration<double>(clock::now() - inicio).count();
+            if (lote < 1024)
+                lote *= 2;
+        }
+        ResultadoBench r{nome, n, pop, iteracoes, decorrido * 1e9 / iteracoes};
+        std::cout << std::left << std::setw(28) << nome << std::right
+                  << std::setw(8) << n << std::setw(8) << pop
+                  << std::setw(12) << iteracoes
+                  << std::setw(16) << std::fixed << std::setprecision(1) << r.ns_por_op << "\n";
+        resultados.push_back(r);
+    }
+
+    bool salvarJSON(const std::string &arquivo) const
+    {
+        std::ofstream f(arquivo);
+        if (!f.is_open())
+            return false;
+
+        std::time_t agora = std::time(nullptr);
+        char data[32];
+        std::strftime(data, sizeof(data), "%Y-%m-%dT%H:%M:%S", std::localtime(&agora));
+
+        f << "{\n  \"contexto\": {\n";
+        f << "    \"data\": \"" << data << "\",\n";
+#if defined(__clang__)
+        f << "    \"compilador\": \"clang " << __clang_major__ << "." << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+        f << "    \"compilador\": \"gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "\",\n";
+#else
+        f << "    \"compilador\": \"desconhecido\",\n";
+#endif
+        f << "    \"tempo_min_s\": " << opcoes.tempo_min << "\n  },\n";
+        f << "  \"resultados\": [\n";
+        for (size_t i = 0; i < resultados.size(); ++i)
+        {
+            const auto &r = resultados[i];
+            f << "    {\"nome\": \"" << r.nome << "\", \"n\": " << r.n << ", \"pop\": " << r.pop
+              << ", \"iteracoes\": " << r.iteracoes
+              << ", \"ns_por_op\": " << std::fixed << std::setprecision(2) << r.ns_por_op
+              << ", \"ops_por_s\": " << std::setprecision(1) << 1e9 / r.ns_por_op << "}"
+              << (i + 1 < resultados.size() ? ",\n" : "\n");
+        }
+        f << "  ]\n}\n";
+        return true;
+    }
+
+    // Kernels que dependem só de n
+    void kernelsPorRota(int n)
+    {
+        InstanciaTSP tsp;
+        tsp.generateUniform(n, 42);
+        GeradorPhilox rng(7);
+        Rota p1 = tsp.randomRota(rng);
+        Rota p2 = tsp.randomRota(rng);
+        Rota filho(n);
+
+        medir("compRota", n, 0, [&]
+              { sumidouro = sumidouro + tsp.compRota(p1); });
+
+        // Backend direto: um kernel por nível SIMD suportado pela CPU
+        if (ativo("compRotaDireta"))
+        {
+            InstanciaTSP direta;
+            direta.configurarDistancias(BackendDistancia::DIRETA);
+            direta.generateUniform(n, 42);
+            const NivelSIMD niveis[] = {NivelSIMD::ESCALAR, NivelSIMD::AVX2, NivelSIMD::AVX512};
+            for (NivelSIMD nivel : niveis)
+            {
+                if (static_cast<int>(nivel) > static_cast<int>(nivelSIMDDisponivel()))
+                    break;
+                direta.definirNivelSIMD(nivel);
+                medir(std::string("compRotaDireta/") + nomeNivelSIMD(nivel), n, 0, [&]
+                      { sumidouro = sumidouro + direta.compRota(p1); });
+            }
+        }
+
+        if (ativo("hashRota"))
+        {
+            HashRotas hash_rotas;
+            hash_rotas.inicializar(n);
+            medir("hashRota", n, 0, [&]
+                  { sumidouro = sumidouro + static_cast<double>(hash_rotas.hash(p1.data(), n) & 0xFF); });
+        }
+
+        GAConfig cfg;
+        cfg.taxa_mutacao = 1.0;
+        GeneticAlgorithm<uint32_t> ga(tsp, cfg);
+        medir("crossoverOrdenado", n, 0, [&]
+              { ga.crossoverOrdenado(p1, p2, filho); });
+        medir("crossoverParcialmenteMapeado", n, 0, [&]
+              { ga.crossoverParcialmenteMapeado(p1, p2, filho); });
+
+        GeradorPhilox gerador(7);
+        if (ativo("crossoverERX"))
+        {
+            CruzamentoERX erx;
+            medir("crossoverERX", n, 0, [&]
+                  { erx.cruzar(p1.data(), p2.data(), filho.data(), n, gerador); });
+        }
+        if (ativo("crossoverEAX"))
+        {
+            ListaVizinhos vizinhos = tsp.listasVizinhos(cfg.vizinhos_busca);
+            CruzamentoEAX eax(tsp, vizinhos);
+            medir("crossoverEAX", n, 0, [&]
+                  { eax.cruzar(p1.data(), p2.data(), filho.data(), n, gerador); });
+        }
+        if (ativo("buscaLocal/array") || ativo("buscaLocal/duasCamadas"))
+        {
+            ListaVizinhos vizinhos = tsp.listasVizinhos(cfg.vizinhos_busca);
+            buscaLocal<TourArray>("buscaLocal/array", tsp, vizinhos, p1);
+            buscaLocal<TourDuasCamadas>("buscaLocal/duasCamadas", tsp, vizinhos, p1);
+        }
+
+        mutacao<GAConfig::TROCA>("mutate/troca", ga, tsp, p1);
+        mutacao<GAConfig::INVERSAO>("mutate/inversao", ga, tsp, p1);
+        mutacao<GAConfig::INSERCAO>("mutate/insercao", ga, tsp, p1);
+    }
+
+    // Uma mutação M por chamada, com a fitness atualizada pelo delta
+    template <GAConfig::MutationType M>
+    void mutacao(const char *nome, GeneticAlgorithm<uint32_t> &ga, const InstanciaTSP &tsp, const Rota &inicial)
+    {
+        if (!ativo(nome))
+            return;
+        Rota rota = inicial;
+        double fitness = tsp.compRota(rota);
+        medir(nome, static_cast<int>(rota.size()), 0, [&]
+              { ga.mutar<M>(rota, fitness); });
+        sumidouro = sumidouro + fitness;
+    }
+
+    // Busca local até o ótimo local a partir de uma rota aleatória
+    // A rota final precisa ser válida e bater com a fitness acompanhada
+    template <typename Tour>
+    void buscaLocal(const std::string &nome, const InstanciaTSP &tsp, const ListaVizinhos &vizinhos,
+                    const Rota &inicial)
+    {
+        if (!ativo(nome))
+            return;
+        BuscaLocal<Tour> busca(tsp, vizinhos);
+        Rota rota;
+        int n = static_cast<int>(inicial.size());
+        double fitness_inicial = tsp.compRota(inicial);
+        double fitness = fitness_inicial;
+        medir(nome, n, 0, [&]
+              {
+                  rota = inicial;
+                  fitness = fitness_inicial;
+                  busca.melhorar(rota.data(), n, fitness);
+                  sumidouro = sumidouro + fitness; });
+        if (!tsp.rotaValida(rota) || std::abs(tsp.compRota(rota) - fitness) > 1e-6 * (1.0 + fitness))
+        {
+            std::cerr << nome << " gerou rota inválida para n=" << n << "\n";
+            ++falhas;
+        }
+    }
+
+    // Seleção de uma geração inteira: preparo + 2 pais por filho
+    void kernelsSelecao(int n, int pop)
+    {
+        InstanciaTSP tsp;
+        tsp.generateUniform(n, 42);
+        selecao<GAConfig::TORNEIO>("selecao/torneio", tsp, pop);
+        selecao<GAConfig::ROLETA>("selecao/roleta", tsp, pop);
+        selecao<GAConfig::RANKING>("selecao/ranking", tsp, pop);
+        selecao<GAConfig::SUS>("selecao/sus", tsp, pop);
+    }
+
+    template <GAConfig::SelectionType S>
+    void selecao(const char *nome, const InstanciaTSP &tsp, int pop)
+    {
+        if (!ativo(nome))
+            return;
+        GAConfig cfg;
+        cfg.tam_populacao = pop;
+        cfg.selection = S;
+        GeneticAlgorithm<uint32_t> ga(tsp, cfg);
+        ga.initPop();
+        int num_elite = std::min(cfg.quant_alpha, pop);
+        medir(nome, tsp.getSize(), pop, [&]
+              {
+                  if (S == GAConfig::RANKING)
+                      ga.ordenarIndices();
+                  ga.prepararSelecao(num_elite);
+                  long soma = 0;
+                  for (int k = num_elite; k < pop; ++k)
+                  {
+                      int parente1, parente2;
+                      ga.escolherPais<S>(k, parente1, parente2);
+                      soma += parente1 + parente2;
+                  }
+                  sumidouro = sumidouro + soma; });
+    }
+
+    // Avaliação em lote de uma população inteira (backend direto)
+    template <typename Gene>
+    void avaliacaoLote(const std::string &nome, int n, int pop)
+    {
+        if (!ativo(nome))
+            return;
+        InstanciaTSP tsp;
+        tsp.configurarDistancias(BackendDistancia::DIRETA);
+        tsp.generateUniform(n, 42);
+        GeradorPhilox rng(7);
+        std::vector<Gene> genes(static_cast<size_t>(pop) * n);
+        for (int i = 0; i < pop; ++i)
+        {
+            Rota r = tsp.randomRota(rng);
+            std::copy(r.begin(), r.end(), genes.begin() + static_cast<size_t>(i) * n);
+        }
+        std::vector<double> fitness(pop);
+        medir(nome, n, pop, [&]
+              {
+                  tsp.compRotas(genes.data(), n, pop, fitness.data());
+                  sumidouro = sumidouro + fitness[0]; });
+    }
+
+    // Genes de 16 bits só existem até MAX_PONTOS_GENE16
+    void kernelsAvaliacao(int n, int pop)
+    {
+        avaliacaoLote<uint32_t>("compRotas/gene32", n, pop);
+        if (n <= MAX_PONTOS_GENE16)
+            avaliacaoLote<uint16_t>("compRotas/gene16", n, pop);
+    }
+
+    // Uma geração completa de evoluir() com a configuração padrão
+    template <typename Gene>
+    void evolucao(const std::string &nome, GAConfig::CrossoverType crossover, int n, int pop)
+    {
+        if (!ativo(nome))
+            return;
+        InstanciaTSP tsp;
+        tsp.generateUniform(n, 42);
+        GAConfig cfg;
+        cfg.tam_populacao = pop;
+        cfg.crossover = crossover;
+        GeneticAlgorithm<Gene> ga(tsp, cfg);
+        ga.initPop();
+        medir(nome, n, pop, [&]
+              { ga.evoluir(); });
+    }
+
+    void kernelsEvolucao(int n, int pop)
+    {
+        const std::pair<const char *, GAConfig::CrossoverType> variantes[] = {
+            {"evoluir/ox", GAConfig::OX},
+            {"evoluir/eax", GAConfig::EAX}};
+        for (const auto &v : variantes)
+        {
+            evolucao<uint32_t>(std::string(v.first) + "/gene32", v.second, n, pop);
+            if (n <= MAX_PONTOS_GENE16)
+                evolucao<uint16_t>(std::string(v.first) + "/gene16", v.second, n, pop);
+        }
+    }
+
+    // Mesma seed em todos os backends exatos (matrizes double e cálculo
+    // direto em cada nível SIMD): comprimentos e evolução iguais bit a bit.
+    // A densa32 arredonda as distâncias e fica de fora
+    void verificarBackends(int n)
+    {
+        const char *nome = "consistencia/backends";
+        if (!ativo(nome) || n > 2000)
+            return;
+        struct Variante
+        {
+            const char *nome;
+            BackendDistancia backend;
+            NivelSIMD nivel;
+        };
+        const Variante variantes[] = {{"densa", BackendDistancia::DENSA, NivelSIMD::ESCALAR},
+                                      {"triangular", BackendDistancia::TRIANGULAR, NivelSIMD::ESCALAR},
+                                      {"direta/escalar", BackendDistancia::DIRETA, NivelSIMD::ESCALAR},
+                                      {"direta/avx2", BackendDistancia::DIRETA, NivelSIMD::AVX2},
+                                      {"direta/avx512", BackendDistancia::DIRETA, NivelSIMD::AVX512}};
+        double comp_ref = 0.0;
+        std::vector<double> historico_ref;
+        bool ok = true;
+        for (const auto &v : variantes)
+        {
+            if (static_cast<int>(v.nivel) > static_cast<int>(nivelSIMDDisponivel()))
+                break;
+            InstanciaTSP tsp;
+            tsp.configurarDistancias(v.backend);
+            tsp.generateUniform(n, 42);
+            tsp.definirNivelSIMD(v.nivel);
+            GeradorPhilox rng(7);
+            double comp = tsp.compRota(tsp.randomRota(rng));
+            GAConfig cfg;
+            cfg.tam_populacao = 50;
+            cfg.num_epocas = 50;
+            GeneticAlgorithm<uint32_t> ga(tsp, cfg);
+            ga.run();
+            if (historico_ref.empty())
+            {
+                comp_ref = comp;
+                historico_ref = ga.getMelhorPorEpoca();
+            }
+            else if (comp != comp_ref || ga.getMelhorPorEpoca() != historico_ref)
+            {
+                std::cerr << nome << ": " << v.nome << " difere de densa para n=" << n << "\n";
+                ok = false;
+            }
+        }
+        if (!ok)
+            ++falhas;
+        std::cout << std::left << std::setw(28) << nome << std::right << std::setw(8) << n
+                  << (ok ? "  iguais" : "  DIFEREM") << "\n";
+    }
+
+    // Devolve false se algum kernel produziu resultado inválido
+    bool executar()
+    {
+        std::cout << std::left << std::setw(28) << "kernel" << std::right
+                  << std::setw(8) << "n" << std::setw(8) << "pop"
+                  << std::setw(12) << "iteracoes" << std::setw(16) << "ns/op" << "\n";
+
+        for (int n : opcoes.ns)
+            verificarBackends(n);
+
+        for (int n : opcoes.ns)
+            kernelsPorRota(n);
+        for (int pop : opcoes.pops)
+            kernelsSelecao(opcoes.ns.front(), pop);
+        for (int n : opcoes.ns)
+            for (int pop : opcoes.pops)
+                kernelsAvaliacao(n, pop);
+        for (int n : opcoes.ns)
+            for (int pop : opcoes.pops)
+                kernelsEvolucao(n, pop);
+        return falhas == 0;
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    OpcoesBench opcoes;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--n" && i + 1 < argc)
+            opcoes.ns = lerLista(argv[++i]);
+        else if (arg == "--pop" && i + 1 < argc)
+            opcoes.pops = lerLista(argv[++i]);
+        else if (arg == "--tempo" && i + 1 < argc)
+            opcoes.tempo_min = std::atof(argv[++i]);
+        else if (arg == "--filtro" && i + 1 < argc)
+            opcoes.filtro = argv[++i];
+        else if (arg == "--json" && i + 1 < argc)
+            opcoes.json = argv[++i];
+        else
+        {
+            std::cerr << "Uso: " << argv[0]
+                      << " [--n 100,1000,10000] [--pop 100,1000] [--tempo 0.2]"
+                         " [--filtro texto] [--json arquivo.json]\n";
+            return 1;
+        }
+    }
+    if (opcoes.ns.empty() || opcoes.pops.empty())
+    {
+        std::cerr << "Erro: listas de n e de população não podem ser vazias\n";
+        return 1;
+    }
+    for (int n : opcoes.ns)
+    {
+        if (n < 8)
+        {
+            std::cerr << "Erro: n deve ser pelo menos 8\n";
+            return 1;
+        }
+    }
+
+    Bancada bancada(opcoes);
+    bool ok = bancada.executar();
+
+    if (!opcoes.json.empty())
+    {
+        if (!bancada.salvarJSON(opcoes.json))
+        {
+            std::cerr << "Erro ao salvar " << opcoes.json << "\n";
+            return 1;
+        }
+        std::cout << "Resultados salvos em " << opcoes.json << "\n";
+    }
+    return ok ? 0 : 1;
+}
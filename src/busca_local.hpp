@@ -0,0 +1,300 @@
+#ifndef BUSCA_LOCAL_HPP
+#define BUSCA_LOCAL_HPP
+
+#include "tsp.hpp"
+#include "tour_duas_camadas.hpp"
+#include <algorithm>
+#include <vector>
+
+// Rota em vetor com posição inversa, orientada a ids de pontos
+// inverter() escolhe o lado mais curto do ciclo, então a orientação global
+// da rota pode mudar após um movimento; por isso os movimentos são descritos
+// por arestas, não por "próximo"/"anterior" fixos
+class TourArray
+{
+private:
+    std::vector<int> tour;
+    std::vector<int> pos;
+    int n = 0;
+
+public:
+    template <typename G>
+    void carregar(const G *rota, int tam)
+    {
+        n = tam;
+        tour.assign(rota, rota + tam);
+        pos.resize(n);
+        for (int i = 0; i < n; ++i)
+            pos[tour[i]] = i;
+    }
+
+    template <typename G>
+    void salvar(G *rota) const
+    {
+        std::copy(tour.begin(), tour.end(), rota);
+    }
+
+    int tamanho() const { return n; }
+    int next(int a) const
+    {
+        int i = pos[a] + 1;
+        return tour[i == n ? 0 : i];
+    }
+    int prev(int a) const
+    {
+        int i = pos[a];
+        return tour[i == 0 ? n - 1 : i - 1];
+    }
+
+    // b está no caminho de a até c (sentido next, extremos inclusos)?
+    bool between(int a, int b, int c) const
+    {
+        int i = pos[a];
+        int j = pos[b];
+        int k = pos[c];
+        return i <= k ? i <= j && j <= k : j >= i || j <= k;
+    }
+
+    // Inverte o caminho de a até b (sentido next); se o caminho complementar
+    // for menor, inverte ele, o que resulta no mesmo ciclo
+    void inverter(int a, int b)
+    {
+        int i = pos[a];
+        int j = pos[b];
+        int len = j - i;
+        if (len < 0)
+            len += n;
+        len += 1;
+        if (2 * len > n)
+        {
+            i = j + 1 == n ? 0 : j + 1;
+            j = pos[a] == 0 ? n - 1 : pos[a] - 1;
+            len = n - len;
+        }
+        for (int t = 0; t < len / 2; ++t)
+        {
+            int x = tour[i];
+            int y = tour[j];
+            tour[i] = y;
+            pos[y] = i;
+            tour[j] = x;
+            pos[x] = j;
+            if (++i == n)
+                i = 0;
+            if (--j < 0)
+                j = n - 1;
+        }
+    }
+};
+
+// A partir deste tamanho o GA usa TourDuasCamadas na busca local; numa busca
+// completa a partir de rota aleatória ela empata perto de n=5000 e fica 7x
+// mais rápida em n=30000 (14x em n=100000)
+constexpr int MIN_PONTOS_DUAS_CAMADAS = 5000;
+
+// Busca local 2-opt + Or-opt restrita a listas de vizinhos candidatos,
+// com don't-look bits: só pontos com arestas alteradas voltam à fila.
+// Cada instância guarda seu próprio espaço de trabalho (uma por thread).
+// Tour é a estrutura da rota durante a busca: TourArray inverte em O(n) com
+// constante baixa; TourDuasCamadas, em O(sqrt(n)), compensa nas instâncias
+// grandes (ver MIN_PONTOS_DUAS_CAMADAS).
+template <typename Tour>
+class BuscaLocal
+{
+private:
+    const InstanciaTSP &tsp;
+    const ListaVizinhos &vizinhos;
+    Tour tour;
+    std::vector<int> fila; // fila circular de pontos a examinar
+    std::vector<char> na_fila;
+    size_t cabeca = 0;
+    size_t contagem = 0;
+
+    static constexpr double EPS = 1e-10;
+
+    void enfileirar(int a)
+    {
+        if (na_fila[a])
+            return;
+        na_fila[a] = 1;
+        fila[(cabeca + contagem) % fila.size()] = a;
+        ++contagem;
+    }
+
+    int desenfileirar()
+    {
+        int a = fila[cabeca];
+        cabeca = (cabeca + 1) % fila.size();
+        --contagem;
+        na_fila[a] = 0;
+        return a;
+    }
+
+    // Sucessor/antecessor conforme o sentido escolhido
+    int seguinte(int a, bool avante) const { return avante ? tour.next(a) : tour.prev(a); }
+
+    // Movimento 2-opt: remove (t1,t2) e (t3,t4), com t2 e t4 sucessores de t1 e t3
+    // no mesmo sentido, e adiciona (t1,t3) e (t2,t4)
+    void mover2opt(int t1, int t2, int t3, int t4)
+    {
+        if (tour.next(t1) == t2)
+            tour.inverter(t2, t3);
+        else
+            tour.inverter(t1, t4);
+    }
+
+    // Tenta um 2-opt melhorador a partir de a; devolve o delta aplicado
+    double tentar2opt(int a)
+    {
+        const int *viz = vizinhos.de(a);
+        for (int sentido = 0; sentido < 2; ++sentido)
+        {
+            bool avante = sentido == 0;
+            int b = seguinte(a, avante);
+            double d_ab = tsp.dist(a, b);
+            for (int v = 0; v < vizinhos.k; ++v)
+            {
+                int c = viz[v];
+                double d_ac = tsp.dist(a, c);
+                if (d_ac >= d_ab - EPS)
+                    break;
+                int d = seguinte(c, avante);
+                if (c == b || d == a)
+                    continue;
+
+                double delta = d_ac + tsp.dist(b, d) - d_ab - tsp.dist(c, d);
+                if (delta < -EPS)
+                {
+                    mover2opt(a, b, c, d);
+                    enfileirar(a);
+                    enfileirar(b);
+                    enfileirar(c);
+                    enfileirar(d);
+                    return delta;
+                }
+            }
+        }
+        return 0.0;
+    }
+
+    // Tenta mover o segmento de até 3 pontos que começa em a para entre dois
+    // pontos vizinhos de uma de suas pontas; devolve o delta aplicado
+    double tentarOrOpt(int a)
+    {
+        int n = tour.tamanho();
+        for (int sentido = 0; sentido < 2; ++sentido)
+        {
+            bool avante = sentido == 0;
+            int s0 = a;
+            int s1 = a;
+            int p = seguinte(s0, !avante);
+            for (int len = 1; len <= 3 && len + 2 < n; ++len)
+            {
+                if (len > 1)
+                    s1 = seguinte(s1, avante);
+                int q = seguinte(s1, avante);
+                if (q == p)
+                    break;
+
+                int meio = len == 3 ? seguinte(s0, avante) : s0;
+                auto noSegmento = [&](int x)
+                { return x == s0 || x == s1 || x == meio; };
+
+                double ganho_remocao = tsp.dist(p, s0) + tsp.dist(s1, q) - tsp.dist(p, q);
+                if (ganho_remocao <= EPS)
+                    continue;
+
+                // Candidatos a partir das duas pontas do segmento
+                for (int ponta = 0; ponta < 2; ++ponta)
+                {
+                    int s = ponta == 0 ? s0 : s1;
+                    const int *viz = vizinhos.de(s);
+                    for (int v = 0; v < vizinhos.k; ++v)
+                    {
+                        int c = viz[v];
+                        double d_sc = tsp.dist(s, c);
+                        if (d_sc >= ganho_remocao - EPS)
+                            break;
+                        if (noSegmento(c))
+                            continue;
+
+                        // Aresta (x, y) com y sucessor de x, contendo c
+                        for (int lado = 0; lado < 2; ++lado)
+                        {
+                            int x = lado == 0 ? c : seguinte(c, !avante);
+                            int y = lado == 0 ? seguinte(c, avante) : c;
+                            if (noSegmento(x) || noSegmento(y))
+                                continue;
+
+                            double d_xy = tsp.dist(x, y);
+                            double direto = tsp.dist(x, s0) + tsp.dist(s1, y) - d_xy;
+                            double invertido = tsp.dist(x, s1) + tsp.dist(s0, y) - d_xy;
+                            bool usar_invertido = invertido < direto;
+                            double delta = (usar_invertido ? invertido : direto) - ganho_remocao;
+                            if (delta < -EPS)
+                            {
+                                aplicarOrOpt(p, s0, s1, q, x, y, usar_invertido);
+                                enfileirar(p);
+                                enfileirar(q);
+                                enfileirar(s0);
+                                enfileirar(s1);
+                                enfileirar(x);
+                                enfileirar(y);
+                                return delta;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return 0.0;
+    }
+
+    // Or-opt como sequência de 2-opts: p s0..s1 q .. x y -> p q .. x [s0..s1] y
+    void aplicarOrOpt(int p, int s0, int s1, int q, int x, int y, bool invertido)
+    {
+        mover2opt(p, s0, x, y); // p x .. q s1..s0 y
+        if (x != q)
+            mover2opt(p, x, q, s1); // p q .. x s1..s0 y
+        if (!invertido)
+            mover2opt(x, s1, s0, y); // p q .. x s0..s1 y
+    }
+
+public:
+    BuscaLocal(const InstanciaTSP &tsp_instance, const ListaVizinhos &listas)
+        : tsp(tsp_instance), vizinhos(listas) {}
+
+    // Melhora a rota até um ótimo local; a fitness é atualizada pelos deltas
+    // A rota é um bloco de n genes; sem alocação depois da primeira chamada
+    template <typename G>
+    void melhorar(G *rota, int n, double &fitness)
+    {
+        if (n < 8 || vizinhos.k == 0)
+            return;
+
+        tour.carregar(rota, n);
+        fila.resize(n);
+        na_fila.assign(n, 0);
+        cabeca = 0;
+        contagem = 0;
+        for (int i = 0; i < n; ++i)
+            enfileirar(rota[i]);
+
+        while (contagem > 0)
+        {
+            int a = desenfileirar();
+            double delta = tentar2opt(a);
+            if (delta == 0.0)
+                delta = tentarOrOpt(a);
+            if (delta != 0.0)
+            {
+                fitness += delta;
+                enfileirar(a);
+            }
+        }
+
+        tour.salvar(rota);
+    }
+};
+
+#endif // BUSCA_LOCAL_HPP
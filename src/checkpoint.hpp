@@ -0,0 +1,215 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define CHECKPOINT_FSYNC 1
+#endif
+
+// Serialização binária dos checkpoints
+// Layout: assinatura (8 bytes), versão (uint32), dados, FNV-1a 64 dos dados.
+// Os valores são gravados na representação nativa da máquina: o checkpoint
+// serve para retomar a execução no mesmo ambiente, não para intercâmbio.
+
+constexpr char ASSINATURA_CHECKPOINT[8] = {'T', 'S', 'P', 'G', 'A', 'C', 'K', '\0'};
+constexpr uint32_t VERSAO_CHECKPOINT = 6; // 6: paciência fora da assinatura da configuração
+
+inline uint64_t hashFNV1a(const char *dados, size_t n)
+{
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; ++i)
+    {
+        h ^= static_cast<unsigned char>(dados[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Acumula os dados do checkpoint num buffer único
+class EscritorBinario
+{
+private:
+    std::vector<char> dados;
+
+    void bytes(const void *p, size_t n)
+    {
+        const char *c = static_cast<const char *>(p);
+        dados.insert(dados.end(), c, c + n);
+    }
+
+public:
+    EscritorBinario()
+    {
+        bytes(ASSINATURA_CHECKPOINT, sizeof(ASSINATURA_CHECKPOINT));
+        valor(VERSAO_CHECKPOINT);
+    }
+
+    template <typename T>
+    void valor(const T &v)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo não serializável");
+        bytes(&v, sizeof(T));
+    }
+
+    template <typename T>
+    void vetor(const std::vector<T> &v)
+    {
+        valor(static_cast<uint64_t>(v.size()));
+        vetor(v.data(), v.size());
+    }
+
+    // Bloco de tamanho conhecido pelo leitor (sem prefixo de tamanho)
+    template <typename T>
+    void vetor(const T *v, size_t n)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo não serializável");
+        bytes(v, n * sizeof(T));
+    }
+
+    // Fecha o buffer com o hash de tudo o que veio antes
+    const std::vector<char> &finalizar()
+    {
+        valor(hashFNV1a(dados.data(), dados.size()));
+        return dados;
+    }
+};
+
+// Lê um checkpoint validando assinatura, versão, hash e limites
+class LeitorBinario
+{
+private:
+    const char *p = nullptr;
+    size_t resto = 0;
+
+    bool bytes(void *destino, size_t n)
+    {
+        if (n > resto)
+            return false;
+        std::memcpy(destino, p, n);
+        p += n;
+        resto -= n;
+        return true;
+    }
+
+public:
+    // Devolve false com a mensagem em erro se o buffer não for um checkpoint íntegro
+    bool abrir(const std::vector<char> &buffer, std::string &erro)
+    {
+        const size_t cabecalho = sizeof(ASSINATURA_CHECKPOINT) + sizeof(uint32_t);
+        if (buffer.size() < cabecalho + sizeof(uint64_t) ||
+            std::memcmp(buffer.data(), ASSINATURA_CHECKPOINT, sizeof(ASSINATURA_CHECKPOINT)) != 0)
+        {
+            erro = "arquivo não é um checkpoint";
+            return false;
+        }
+        uint32_t versao;
+        std::memcpy(&versao, buffer.data() + sizeof(ASSINATURA_CHECKPOINT), sizeof(versao));
+        if (versao != VERSAO_CHECKPOINT)
+        {
+            erro = "versão de checkpoint não suportada (" + std::to_string(versao) + ")";
+            return false;
+        }
+        size_t corpo = buffer.size() - sizeof(uint64_t);
+        uint64_t hash;
+        std::memcpy(&hash, buffer.data() + corpo, sizeof(hash));
+        if (hash != hashFNV1a(buffer.data(), corpo))
+        {
+            erro = "checkpoint corrompido ou truncado";
+            return false;
+        }
+        p = buffer.data() + cabecalho;
+        resto = corpo - cabecalho;
+        return true;
+    }
+
+    template <typename T>
+    bool valor(T &v)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo não serializável");
+        return bytes(&v, sizeof(T));
+    }
+
+    template <typename T>
+    bool vetor(std::vector<T> &v)
+    {
+        uint64_t n;
+        if (!valor(n) || n > resto / sizeof(T))
+            return false;
+        v.resize(static_cast<size_t>(n));
+        return vetor(v.data(), v.size());
+    }
+
+    template <typename T>
+    bool vetor(T *v, size_t n)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "tipo não serializável");
+        return n <= resto / sizeof(T) && bytes(v, n * sizeof(T));
+    }
+
+    bool fim() const { return resto == 0; }
+};
+
+// Grava num arquivo temporário ao lado do destino e o renomeia por cima:
+// uma interrupção no meio da escrita deixa o checkpoint anterior intacto
+inline bool gravarArquivoAtomico(const std::string &caminho, const std::vector<char> &dados, std::string &erro)
+{
+    std::string temporario = caminho + ".tmp";
+    std::FILE *f = std::fopen(temporario.c_str(), "wb");
+    if (!f)
+    {
+        erro = "não foi possível criar " + temporario;
+        return false;
+    }
+    bool ok = std::fwrite(dados.data(), 1, dados.size(), f) == dados.size() && std::fflush(f) == 0;
+#ifdef CHECKPOINT_FSYNC
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok)
+    {
+        erro = "falha ao gravar " + temporario;
+        std::remove(temporario.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporario, caminho, ec);
+    if (ec)
+    {
+        erro = "falha ao renomear " + temporario + ": " + ec.message();
+        std::remove(temporario.c_str());
+        return false;
+    }
+    return true;
+}
+
+inline bool lerArquivoBinario(const std::string &caminho, std::vector<char> &dados, std::string &erro)
+{
+    std::FILE *f = std::fopen(caminho.c_str(), "rb");
+    if (!f)
+    {
+        erro = "não foi possível abrir " + caminho;
+        return false;
+    }
+    dados.clear();
+    char bloco[1 << 16];
+    size_t lidos;
+    while ((lidos = std::fread(bloco, 1, sizeof(bloco), f)) > 0)
+        dados.insert(dados.end(), bloco, bloco + lidos);
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    if (!ok)
+        erro = "falha ao ler " + caminho;
+    return ok;
+}
+
+#endif // CHECKPOINT_HPP
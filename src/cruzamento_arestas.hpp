@@ -0,0 +1,434 @@
+#ifndef CRUZAMENTO_ARESTAS_HPP
+#define CRUZAMENTO_ARESTAS_HPP
+
+#include "tsp.hpp"
+#include "philox.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Crossovers que preservam arestas (e não posições) dos pais
+// Cada classe guarda seu espaço de trabalho em vetores de adjacência, então
+// há uma instância por trabalhador e nenhuma alocação depois da primeira chamada.
+// Pais e filho são blocos de genes de qualquer largura (G); o espaço de
+// trabalho interno é sempre int.
+
+// Edge Recombination (ERX)
+// Tabela com a união das arestas dos dois pais (até 4 vizinhos por ponto);
+// a partir do ponto atual segue o vizinho com menos vizinhos restantes
+// e, se não houver nenhum, salta para um ponto livre sorteado
+class CruzamentoERX
+{
+private:
+    std::vector<int> adj;  // adj[4a .. 4a+grau[a]) = vizinhos restantes de a
+    std::vector<int> grau; // -1 = já visitado
+    std::vector<int> livres, pos_livre;
+
+    void adicionar(int a, int b)
+    {
+        int *viz = &adj[4 * a];
+        for (int i = 0; i < grau[a]; ++i)
+            if (viz[i] == b)
+                return;
+        viz[grau[a]++] = b;
+    }
+
+    void remover(int a, int b)
+    {
+        int *viz = &adj[4 * a];
+        for (int i = 0; i < grau[a]; ++i)
+        {
+            if (viz[i] == b)
+            {
+                viz[i] = viz[--grau[a]];
+                return;
+            }
+        }
+    }
+
+public:
+    template <typename G>
+    void cruzar(const G *parente1, const G *parente2, G *filho, int n, GeradorPhilox &rng)
+    {
+        adj.resize(4 * static_cast<size_t>(n));
+        grau.assign(n, 0);
+        livres.resize(n);
+        pos_livre.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            livres[i] = i;
+            pos_livre[i] = i;
+        }
+
+        for (const G *p : {parente1, parente2})
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                int a = p[i];
+                int b = p[i + 1 == n ? 0 : i + 1];
+                adicionar(a, b);
+                adicionar(b, a);
+            }
+        }
+
+        int num_livres = n;
+        int atual = parente1[0];
+        for (int k = 0; k < n; ++k)
+        {
+            filho[k] = atual;
+
+            // Retira atual dos livres e das listas dos seus vizinhos
+            int p = pos_livre[atual];
+            int ultimo = livres[--num_livres];
+            livres[p] = ultimo;
+            pos_livre[ultimo] = p;
+            const int *viz = &adj[4 * atual];
+            for (int i = 0; i < grau[atual]; ++i)
+                remover(viz[i], atual);
+            if (num_livres == 0)
+                break;
+
+            // Vizinho com menos vizinhos restantes; empates sorteados
+            int proximo = -1;
+            int empates = 0;
+            for (int i = 0; i < grau[atual]; ++i)
+            {
+                int v = viz[i];
+                if (proximo < 0 || grau[v] < grau[proximo])
+                {
+                    proximo = v;
+                    empates = 1;
+                }
+                else if (grau[v] == grau[proximo] &&
+                         rng.inteiro(0, empates++) == 0)
+                {
+                    proximo = v;
+                }
+            }
+            grau[atual] = -1;
+            if (proximo < 0)
+                proximo = livres[rng.inteiro(0, num_livres - 1)];
+            atual = proximo;
+        }
+    }
+};
+
+// Edge Assembly Crossover (EAX), estratégia de um AB-ciclo
+// 1. G_AB = arestas de A e de B, sem as comuns;
+// 2. G_AB é decomposto em AB-ciclos (arestas alternadas de A e de B);
+// 3. um AB-ciclo sorteado é aplicado a A: saem suas arestas de A, entram as de B,
+//    o que gera uma solução intermediária formada por sub-rotas;
+// 4. as sub-rotas são fundidas, da menor para a maior, pela troca 2-opt mais
+//    barata entre uma aresta da sub-rota e uma aresta de um ponto vizinho candidato.
+class CruzamentoEAX
+{
+private:
+    const InstanciaTSP &tsp;
+    const ListaVizinhos &vizinhos;
+
+    // Arestas restantes de G_AB por ponto (2 de A e 2 de B; -1 = vazio)
+    std::vector<int> resto_a, resto_b;
+    // Caminho alternado em construção e ocorrência de cada ponto por paridade
+    std::vector<int> caminho;
+    std::vector<int> ocorrencia;
+    // AB-ciclos: pontos c0..c(2k-1) com (c0,c1) de A, (c1,c2) de B, ...
+    std::vector<int> ciclos;
+    std::vector<int> inicio_ciclo;
+    // Solução intermediária: dois vizinhos por ponto
+    std::vector<int> ligacao;
+    std::vector<int> sub_rota;    // rótulo da sub-rota de cada ponto
+    std::vector<int> tam_sub;     // tamanho por rótulo (0 = fundida)
+    std::vector<int> repr_sub;    // um ponto de cada sub-rota
+    std::vector<int> membros;     // pontos da sub-rota sendo fundida
+
+    static bool removerDe(int *par, int v)
+    {
+        if (par[0] == v)
+        {
+            par[0] = -1;
+            return true;
+        }
+        if (par[1] == v)
+        {
+            par[1] = -1;
+            return true;
+        }
+        return false;
+    }
+
+    static void inserirEm(int *par, int v)
+    {
+        if (par[0] < 0)
+            par[0] = v;
+        else
+            par[1] = v;
+    }
+
+    static void trocarEm(int *par, int antigo, int novo)
+    {
+        if (par[0] == antigo)
+            par[0] = novo;
+        else
+            par[1] = novo;
+    }
+
+    template <typename G>
+    void ligarPais(const G *rota, int n, std::vector<int> &adj)
+    {
+        adj.resize(2 * static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i)
+        {
+            int a = rota[i];
+            adj[2 * a] = rota[i == 0 ? n - 1 : i - 1];
+            adj[2 * a + 1] = rota[i + 1 == n ? 0 : i + 1];
+        }
+    }
+
+    // Sorteia uma aresta restante do tipo pedido em a (a de A se de_a)
+    int tomarAresta(int a, bool de_a, GeradorPhilox &rng)
+    {
+        std::vector<int> &resto = de_a ? resto_a : resto_b;
+        int *par = &resto[2 * a];
+        int s;
+        if (par[0] >= 0 && par[1] >= 0)
+            s = rng.inteiro(0, 1);
+        else
+            s = par[0] >= 0 ? 0 : 1;
+        int b = par[s];
+        par[s] = -1;
+        removerDe(&resto[2 * b], a);
+        return b;
+    }
+
+    // Decompõe G_AB em AB-ciclos por caminhada alternada: a aresta e_i do
+    // caminho é de A se i é par; ao voltar a um ponto com a paridade certa,
+    // o trecho fechado vira um AB-ciclo e a caminhada continua dali
+    void construirCiclos(int n, GeradorPhilox &rng)
+    {
+        ciclos.clear();
+        inicio_ciclo.clear();
+        ocorrencia.assign(2 * static_cast<size_t>(n), -1);
+
+        int deslocamento = rng.inteiro(0, n - 1);
+        for (int t = 0; t < n; ++t)
+        {
+            int v0 = (t + deslocamento) % n;
+            if (resto_a[2 * v0] < 0 && resto_a[2 * v0 + 1] < 0)
+                continue;
+
+            caminho.clear();
+            caminho.push_back(v0);
+            ocorrencia[2 * v0] = 0;
+            while (!caminho.empty())
+            {
+                int m = static_cast<int>(caminho.size());
+                int atual = caminho.back();
+                bool de_a = (m - 1) % 2 == 0;
+                const int *par = de_a ? &resto_a[2 * atual] : &resto_b[2 * atual];
+                if (par[0] < 0 && par[1] < 0)
+                {
+                    // Só acontece em v0 com todas as arestas consumidas
+                    ocorrencia[2 * atual + (m - 1) % 2] = -1;
+                    caminho.pop_back();
+                    continue;
+                }
+
+                int prox = tomarAresta(atual, de_a, rng);
+                int j = ocorrencia[2 * prox + m % 2];
+                if (j < 0)
+                {
+                    ocorrencia[2 * prox + m % 2] = m;
+                    caminho.push_back(prox);
+                    continue;
+                }
+
+                // Fecha o ciclo caminho[j..m-1] -> prox; começa por uma aresta de A
+                inicio_ciclo.push_back(static_cast<int>(ciclos.size()));
+                if (j % 2 == 0)
+                {
+                    ciclos.insert(ciclos.end(), caminho.begin() + j, caminho.end());
+                }
+                else
+                {
+                    ciclos.insert(ciclos.end(), caminho.begin() + j + 1, caminho.end());
+                    ciclos.push_back(caminho[j]);
+                }
+                for (int i = j + 1; i < m; ++i)
+                    ocorrencia[2 * caminho[i] + i % 2] = -1;
+                caminho.resize(j + 1);
+            }
+        }
+        inicio_ciclo.push_back(static_cast<int>(ciclos.size()));
+    }
+
+    // Rotula as sub-rotas da solução intermediária; devolve quantas há
+    int rotularSubRotas(int n)
+    {
+        sub_rota.assign(n, -1);
+        tam_sub.clear();
+        repr_sub.clear();
+        for (int s = 0; s < n; ++s)
+        {
+            if (sub_rota[s] >= 0)
+                continue;
+            int rotulo = static_cast<int>(tam_sub.size());
+            int tam = 0;
+            int anterior = -1;
+            int atual = s;
+            do
+            {
+                sub_rota[atual] = rotulo;
+                ++tam;
+                int prox = ligacao[2 * atual] != anterior ? ligacao[2 * atual] : ligacao[2 * atual + 1];
+                anterior = atual;
+                atual = prox;
+            } while (atual != s);
+            tam_sub.push_back(tam);
+            repr_sub.push_back(s);
+        }
+        return static_cast<int>(tam_sub.size());
+    }
+
+    // Funde a menor sub-rota a outra pela troca de duas arestas mais barata
+    void fundirMenor(int n)
+    {
+        int u_rotulo = -1;
+        for (int r = 0; r < static_cast<int>(tam_sub.size()); ++r)
+        {
+            if (tam_sub[r] > 0 && (u_rotulo < 0 || tam_sub[r] < tam_sub[u_rotulo]))
+                u_rotulo = r;
+        }
+
+        membros.clear();
+        int anterior = -1;
+        int atual = repr_sub[u_rotulo];
+        do
+        {
+            membros.push_back(atual);
+            int prox = ligacao[2 * atual] != anterior ? ligacao[2 * atual] : ligacao[2 * atual + 1];
+            anterior = atual;
+            atual = prox;
+        } while (atual != repr_sub[u_rotulo]);
+
+        double melhor = std::numeric_limits<double>::max();
+        int mu = -1, mu2 = -1, mv = -1, mv2 = -1;
+        auto avaliar = [&](int u, int v)
+        {
+            for (int s = 0; s < 2; ++s)
+            {
+                int u2 = ligacao[2 * u + s];
+                double d_uu2 = tsp.dist(u, u2);
+                for (int t = 0; t < 2; ++t)
+                {
+                    int v2 = ligacao[2 * v + t];
+                    double base = d_uu2 + tsp.dist(v, v2);
+                    // (u,u2),(v,v2) -> (u,v),(u2,v2)
+                    double custo = tsp.dist(u, v) + tsp.dist(u2, v2) - base;
+                    if (custo < melhor)
+                    {
+                        melhor = custo;
+                        mu = u, mu2 = u2, mv = v, mv2 = v2;
+                    }
+                }
+            }
+        };
+        for (int u : membros)
+        {
+            const int *viz = vizinhos.de(u);
+            for (int k = 0; k < vizinhos.k; ++k)
+            {
+                if (sub_rota[viz[k]] != u_rotulo)
+                    avaliar(u, viz[k]);
+            }
+        }
+        if (mu < 0)
+        {
+            // Nenhum candidato fora da sub-rota: varredura completa
+            for (int u : membros)
+                for (int v = 0; v < n; ++v)
+                    if (sub_rota[v] != u_rotulo)
+                        avaliar(u, v);
+        }
+
+        trocarEm(&ligacao[2 * mu], mu2, mv);
+        trocarEm(&ligacao[2 * mu2], mu, mv2);
+        trocarEm(&ligacao[2 * mv], mv2, mu);
+        trocarEm(&ligacao[2 * mv2], mv, mu2);
+
+        int destino = sub_rota[mv];
+        for (int u : membros)
+            sub_rota[u] = destino;
+        tam_sub[destino] += tam_sub[u_rotulo];
+        tam_sub[u_rotulo] = 0;
+    }
+
+public:
+    CruzamentoEAX(const InstanciaTSP &tsp_instance, const ListaVizinhos &listas)
+        : tsp(tsp_instance), vizinhos(listas) {}
+
+    // Filho a partir de A = parente1 e B = parente2; se os pais forem iguais
+    // (G_AB vazio), o filho é cópia de A
+    template <typename G>
+    void cruzar(const G *parente1, const G *parente2, G *filho, int n, GeradorPhilox &rng)
+    {
+        ligarPais(parente1, n, resto_a);
+        ligarPais(parente2, n, resto_b);
+        ligacao = resto_a;
+
+        // Remove as arestas comuns de G_AB
+        for (int a = 0; a < n; ++a)
+        {
+            for (int s = 0; s < 2; ++s)
+            {
+                int b = resto_a[2 * a + s];
+                if (b >= 0 && removerDe(&resto_b[2 * a], b))
+                {
+                    resto_a[2 * a + s] = -1;
+                    removerDe(&resto_a[2 * b], a);
+                    removerDe(&resto_b[2 * b], a);
+                }
+            }
+        }
+
+        construirCiclos(n, rng);
+        int num_ciclos = static_cast<int>(inicio_ciclo.size()) - 1;
+        if (num_ciclos > 0)
+        {
+            // E-set: um AB-ciclo sorteado aplicado a A
+            int c = rng.inteiro(0, num_ciclos - 1);
+            const int *ciclo = ciclos.data() + inicio_ciclo[c];
+            int tam = inicio_ciclo[c + 1] - inicio_ciclo[c];
+            for (int i = 0; i < tam; i += 2)
+            {
+                int a = ciclo[i];
+                int b = ciclo[i + 1];
+                removerDe(&ligacao[2 * a], b);
+                removerDe(&ligacao[2 * b], a);
+            }
+            for (int i = 1; i < tam; i += 2)
+            {
+                int a = ciclo[i];
+                int b = ciclo[i + 1 == tam ? 0 : i + 1];
+                inserirEm(&ligacao[2 * a], b);
+                inserirEm(&ligacao[2 * b], a);
+            }
+
+            int num_sub = rotularSubRotas(n);
+            for (int k = 1; k < num_sub; ++k)
+                fundirMenor(n);
+        }
+
+        // Percorre o ciclo final a partir do primeiro ponto de A
+        int anterior = -1;
+        int atual = parente1[0];
+        for (int i = 0; i < n; ++i)
+        {
+            filho[i] = atual;
+            int prox = ligacao[2 * atual] != anterior ? ligacao[2 * atual] : ligacao[2 * atual + 1];
+            anterior = atual;
+            atual = prox;
+        }
+    }
+};
+
+#endif // CRUZAMENTO_ARESTAS_HPP
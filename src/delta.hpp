@@ -0,0 +1,141 @@
+#ifndef DELTA_HPP
+#define DELTA_HPP
+
+#include "tsp.hpp"
+#include <algorithm>
+
+// Avaliação incremental de movimentos sobre uma rota
+// Cada função delta* devolve (novo comprimento - comprimento atual) olhando
+// apenas as arestas afetadas, em O(1); aplicar* executa o movimento.
+// Posições são índices na rota (não ids de pontos); a rota é um bloco de n
+// genes (de qualquer largura), podendo ser uma linha do buffer da população.
+
+// Troca os pontos nas posições i e j
+template <typename G>
+inline double deltaTroca(const InstanciaTSP &tsp, const G *rota, int n, int i, int j)
+{
+    if (i == j || n <= 3)
+        return 0.0;
+    if (i > j)
+        std::swap(i, j);
+
+    int a = rota[i];
+    int b = rota[j];
+    int ant_i = rota[(i - 1 + n) % n];
+    int prox_i = rota[i + 1];
+    int ant_j = rota[j - 1];
+    int prox_j = rota[(j + 1) % n];
+
+    // Adjacentes: ant_i, a, b, prox_j -> ant_i, b, a, prox_j
+    if (j == i + 1)
+    {
+        return tsp.dist(ant_i, b) + tsp.dist(a, prox_j) - tsp.dist(ant_i, a) - tsp.dist(b, prox_j);
+    }
+    // Adjacentes pela volta: ant_j, b, a, prox_i -> ant_j, a, b, prox_i
+    if (i == 0 && j == n - 1)
+    {
+        return tsp.dist(ant_j, a) + tsp.dist(b, prox_i) - tsp.dist(ant_j, b) - tsp.dist(a, prox_i);
+    }
+
+    double removido = tsp.dist(ant_i, a) + tsp.dist(a, prox_i) + tsp.dist(ant_j, b) + tsp.dist(b, prox_j);
+    double inserido = tsp.dist(ant_i, b) + tsp.dist(b, prox_i) + tsp.dist(ant_j, a) + tsp.dist(a, prox_j);
+    return inserido - removido;
+}
+
+template <typename G>
+inline void aplicarTroca(G *rota, int i, int j)
+{
+    std::swap(rota[i], rota[j]);
+}
+
+// Inversão (2-opt) do segmento [i, j], com i <= j
+// Substitui as arestas (r[i-1], r[i]) e (r[j], r[j+1]) por (r[i-1], r[j]) e (r[i], r[j+1])
+template <typename G>
+inline double deltaInversao(const InstanciaTSP &tsp, const G *rota, int n, int i, int j)
+{
+    if (i >= j || (i == 0 && j == n - 1))
+        return 0.0;
+
+    int a = rota[(i - 1 + n) % n];
+    int b = rota[i];
+    int c = rota[j];
+    int d = rota[(j + 1) % n];
+    return tsp.dist(a, c) + tsp.dist(b, d) - tsp.dist(a, b) - tsp.dist(c, d);
+}
+
+template <typename G>
+inline void aplicarInversao(G *rota, int i, int j)
+{
+    std::reverse(rota + i, rota + j + 1);
+}
+
+// Or-opt: move o segmento [i, i+len-1] para logo depois da posição j
+// O segmento não dá a volta (i + len <= n) e j fica fora dele;
+// com invertido = true o segmento é reinserido na ordem contrária
+template <typename G>
+inline double deltaOrOpt(const InstanciaTSP &tsp, const G *rota, int n, int i, int len, int j,
+                         bool invertido = false)
+{
+    int fim = i + len - 1;
+    if (len <= 0 || len >= n - 1 || j == (i - 1 + n) % n)
+        return invertido ? deltaInversao(tsp, rota, n, i, fim) : 0.0;
+
+    int s0 = rota[i];
+    int s1 = rota[fim];
+    int p = rota[(i - 1 + n) % n];
+    int q = rota[(fim + 1) % n];
+
+    // j != i-1, logo o sucessor de r[j] não pertence ao segmento
+    int u = rota[j];
+    int v = rota[(j + 1) % n];
+
+    double remocao = tsp.dist(p, q) - tsp.dist(p, s0) - tsp.dist(s1, q);
+    double insercao = invertido
+                          ? tsp.dist(u, s1) + tsp.dist(s0, v) - tsp.dist(u, v)
+                          : tsp.dist(u, s0) + tsp.dist(s1, v) - tsp.dist(u, v);
+    return remocao + insercao;
+}
+
+template <typename G>
+inline void aplicarOrOpt(G *rota, int n, int i, int len, int j, bool invertido = false)
+{
+    int fim = i + len;
+    if (len <= 0 || len >= n - 1 || j == (i - 1 + n) % n)
+    {
+        if (invertido)
+            std::reverse(rota + i, rota + fim);
+        return;
+    }
+
+    int novo_inicio;
+    if (j >= fim)
+    {
+        std::rotate(rota + i, rota + fim, rota + j + 1);
+        novo_inicio = j + 1 - len;
+    }
+    else
+    {
+        std::rotate(rota + j + 1, rota + i, rota + fim);
+        novo_inicio = j + 1;
+    }
+    if (invertido)
+        std::reverse(rota + novo_inicio, rota + novo_inicio + len);
+}
+
+// Inserção: retira o ponto da posição i e o recoloca depois da posição j
+template <typename G>
+inline double deltaInsercao(const InstanciaTSP &tsp, const G *rota, int n, int i, int j)
+{
+    if (i == j)
+        return 0.0;
+    return deltaOrOpt(tsp, rota, n, i, 1, j);
+}
+
+template <typename G>
+inline void aplicarInsercao(G *rota, int n, int i, int j)
+{
+    if (i != j)
+        aplicarOrOpt(rota, n, i, 1, j);
+}
+
+#endif // DELTA_HPP
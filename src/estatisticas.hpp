@@ -0,0 +1,63 @@
+#ifndef ESTATISTICAS_HPP
+#define ESTATISTICAS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Resumo da fitness de uma geração
+struct EstatisticasGeracao
+{
+    double melhor = std::numeric_limits<double>::max();
+    double media = 0.0;
+    double pior = 0.0;
+    double desvio = 0.0; // desvio padrão populacional
+    double mediana = 0.0;
+    int indice_melhor = -1;
+    int indice_pior = -1;
+};
+
+// Melhor/média/pior/desvio numa única passada (Welford) e mediana por
+// seleção em O(n) sobre uma cópia em trabalho (reaproveitada entre gerações)
+inline EstatisticasGeracao calcularEstatisticas(const double *fitness, int n, std::vector<double> &trabalho)
+{
+    EstatisticasGeracao e;
+    if (n <= 0)
+        return e;
+
+    double media = 0.0;
+    double m2 = 0.0;
+    e.indice_melhor = 0;
+    e.indice_pior = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        double f = fitness[i];
+        if (f < fitness[e.indice_melhor])
+            e.indice_melhor = i;
+        if (f > fitness[e.indice_pior])
+            e.indice_pior = i;
+        double d = f - media;
+        media += d / (i + 1);
+        m2 += d * (f - media);
+    }
+    e.melhor = fitness[e.indice_melhor];
+    e.pior = fitness[e.indice_pior];
+    e.media = media;
+    e.desvio = std::sqrt(std::max(0.0, m2 / n));
+
+    trabalho.assign(fitness, fitness + n);
+    int meio = n / 2;
+    std::nth_element(trabalho.begin(), trabalho.begin() + meio, trabalho.end());
+    e.mediana = trabalho[meio];
+    if (n % 2 == 0)
+    {
+        // Com n par, a mediana é a média dos dois centrais; o outro é o
+        // maior da metade inferior
+        double inferior = *std::max_element(trabalho.begin(), trabalho.begin() + meio);
+        e.mediana = 0.5 * (e.mediana + inferior);
+    }
+    return e;
+}
+
+#endif // ESTATISTICAS_HPP
@@ -2,10 +2,23 @@
 #define GA_HPP
 
 #include "tsp.hpp"
+#include "delta.hpp"
+#include "pool_threads.hpp"
+#include "busca_local.hpp"
+#include "cruzamento_arestas.hpp"
+#include "semeadura.hpp"
+#include "selecao.hpp"
+#include "estatisticas.hpp"
+#include "hash_rota.hpp"
+#include "perfil.hpp"
+#include "checkpoint.hpp"
+#include "philox.hpp"
 #include <vector>
 #include <random>
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
+#include <memory>
 #include <set>
 
 // Indivíduo na população do GA
@@ -33,75 +46,434 @@ struct GAConfig
     int quant_alpha = 2;
     int paciencia = 100;
 
+    // ROLETA: proporcional a (pior - fitness + 1); RANKING: linear pela
+    // posição, com pressão seletiva pressao_ranking em [1, 2];
+    // SUS: amostragem universal estocástica com os pesos da roleta
     enum SelectionType
     {
         TORNEIO,
-        ROLETA
+        ROLETA,
+        RANKING,
+        SUS
     };
     SelectionType selection = TORNEIO;
+    double pressao_ranking = 1.5;
 
+    // OX/PMX preservam ordem e posições; ERX e EAX preservam arestas
+    // (EAX usa as listas de vizinhos com vizinhos_busca candidatos)
     enum CrossoverType
     {
         OX,
-        PMX
+        PMX,
+        ERX,
+        EAX
     };
     CrossoverType crossover = OX;
 
+    enum MutationType
+    {
+        TROCA,
+        INVERSAO,
+        INSERCAO
+    };
+    MutationType mutacao = TROCA;
+
+    // Probabilidade de cruzamento; sem cruzamento o filho é cópia do parente1
+    // e herda sua fitness, então só a mutação (incremental) é avaliada
+    double taxa_cruzamento = 1.0;
+
+    // Modo memético: busca local (2-opt + Or-opt) aplicada aos filhos
+    // TODOS: todo filho; ELITE: os quant_alpha melhores filhos de cada geração;
+    // AMOSTRA: cada filho com probabilidade taxa_busca_local
+    enum BuscaLocalType
+    {
+        SEM_BUSCA,
+        BUSCA_TODOS,
+        BUSCA_ELITE,
+        BUSCA_AMOSTRA
+    };
+    BuscaLocalType busca_local = SEM_BUSCA;
+    double taxa_busca_local = 0.1;
+    int vizinhos_busca = 8; // tamanho das listas de candidatos
+
+    // Semeadura da população inicial: uma fração fracao_semeada recebe rotas
+    // heurísticas (MISTA alterna vizinho mais próximo, guloso e Hilbert) e o
+    // restante continua aleatório
+    enum SemeaduraType
+    {
+        ALEATORIA,
+        VIZINHO_MAIS_PROXIMO,
+        GULOSA,
+        HILBERT,
+        MISTA
+    };
+    SemeaduraType semeadura = ALEATORIA;
+    double fracao_semeada = 0.5;
+
+    // Hash de rotas: com cache_fitness, o filho idêntico (mesmas arestas) a
+    // uma rota da população atual herda sua fitness sem compRota. O hash custa
+    // O(n) como o compRota com matriz densa, então o cache compensa quando a
+    // distância é calculada (backend DIRETA) e a população já convergiu.
+    // duplicatas decide o que fazer com esses filhos: PERMITIR mantém,
+    // REJEITAR refaz o filho e MUTAR aplica a mutação até ele ficar distinto
+    // (até 3 tentativas)
+    bool cache_fitness = false;
+    enum DuplicataType
+    {
+        PERMITIR,
+        REJEITAR,
+        MUTAR
+    };
+    DuplicataType duplicatas = PERMITIR;
+
+    // Threads usadas para gerar os filhos (1 = sequencial)
+    // O resultado depende só da seed, não do número de threads
+    int num_threads = 1;
+
     int seed = 42;
 };
 
-// Algoritmo Genético para TSP
+// Fluxos do gerador do GA: todo sorteio vem do fluxo (domínio, época, índice),
+// então o resultado não depende de qual trabalhador produz cada filho
+enum FluxoAleatorio : uint32_t
+{
+    FLUXO_INICIAL = 0, // índice = indivíduo da população inicial
+    FLUXO_SELECAO = 1, // sorteios da geração feitos antes da fase paralela
+    FLUXO_FILHO = 2,   // índice = posição do filho na próxima população
+    FLUXO_MIGRACAO = 3 // índice = ilha de origem (modelo de ilhas)
+};
+
+// Estado próprio de cada trabalhador na geração de filhos:
+// gerador aleatório e buffers dos crossovers (pertinência por carimbo)
+struct ContextoTrabalhador
+{
+    GeradorPhilox rng;
+    std::vector<unsigned> marca;
+    std::vector<int> mapeamento;
+    unsigned carimbo_atual = 0;
+
+    // Espaço de trabalho da busca local (nulo fora do modo memético); só um
+    // dos dois existe, conforme o tamanho da instância
+    std::unique_ptr<BuscaLocal<TourArray>> busca_local;
+    std::unique_ptr<BuscaLocal<TourDuasCamadas>> busca_local_camadas;
+
+    // Espaço de trabalho dos crossovers por arestas (EAX é nulo se não usado)
+    CruzamentoERX erx;
+    std::unique_ptr<CruzamentoEAX> eax;
+
+    // Avaliações evitadas pelo cache e duplicatas tratadas
+    long avaliacoes_poupadas = 0;
+    long duplicatas = 0;
+
+#ifdef TSP_PERFIL
+    ContadoresFase perfil; // fases executadas por este trabalhador na época
+#endif
+
+    // Devolve um carimbo novo; zera as marcas só quando o contador dá a volta
+    unsigned novoCarimbo(int n)
+    {
+        if (marca.size() != static_cast<size_t>(n))
+        {
+            marca.assign(n, 0);
+            mapeamento.assign(n, -1);
+            carimbo_atual = 0;
+        }
+        if (++carimbo_atual == 0)
+        {
+            std::fill(marca.begin(), marca.end(), 0);
+            carimbo_atual = 1;
+        }
+        return carimbo_atual;
+    }
+};
+
+// População em um único buffer contíguo de tam x n genes
+// A rota i ocupa genes[i*n, (i+1)*n); fitness e hash ficam em vetores
+// paralelos (o hash só é mantido quando o GA usa hash de rotas).
+// O GA mantém duas (atual e próxima) e troca os buffers a cada geração.
+// Gene é o tipo do índice de ponto: uint16_t basta até 65535 pontos e
+// reduz à metade a memória percorrida no cruzamento, avaliação e cópias.
+template <typename Gene>
+struct Populacao
+{
+    int n = 0;
+    int tam = 0;
+    std::vector<Gene> genes;
+    std::vector<double> fitness;
+    std::vector<uint64_t> hash;
+
+    void redimensionar(int tam_, int n_)
+    {
+        tam = tam_;
+        n = n_;
+        genes.resize(static_cast<size_t>(tam) * n);
+        fitness.resize(tam);
+        hash.resize(tam);
+    }
+
+    Gene *rota(int i) { return genes.data() + static_cast<size_t>(i) * n; }
+    const Gene *rota(int i) const { return genes.data() + static_cast<size_t>(i) * n; }
+
+    // Copia a linha i de origem para a linha destino
+    void copiar(int destino, const Populacao &origem, int i)
+    {
+        std::copy(origem.rota(i), origem.rota(i) + n, rota(destino));
+        fitness[destino] = origem.fitness[i];
+        hash[destino] = origem.hash[i];
+    }
+
+    void definir(int i, const Rota &r, double f)
+    {
+        std::copy(r.begin(), r.end(), rota(i));
+        fitness[i] = f;
+    }
+
+    Individual individuo(int i) const
+    {
+        return Individual(Rota(rota(i), rota(i) + n), fitness[i]);
+    }
+
+    void trocar(Populacao &outra)
+    {
+        genes.swap(outra.genes);
+        fitness.swap(outra.fitness);
+        hash.swap(outra.hash);
+        std::swap(tam, outra.tam);
+        std::swap(n, outra.n);
+    }
+};
+
+// Maior instância representável com genes de 16 bits
+constexpr int MAX_PONTOS_GENE16 = 65535;
+
+// Chama fn com um valor do tipo de gene adequado a n pontos (uint16_t ou
+// uint32_t); fn é genérica, ex.: [&](auto gene) { GeneticAlgorithm<decltype(gene)> ga(...); }
+template <typename Fn>
+auto comTipoGene(int n, Fn &&fn)
+{
+    if (n <= MAX_PONTOS_GENE16)
+        return fn(uint16_t{});
+    return fn(uint32_t{});
+}
+
+// Algoritmo Genético para TSP, instanciado para genes de 16 e 32 bits
+template <typename Gene>
 class GeneticAlgorithm
 {
 protected:
     const InstanciaTSP &tsp;
     GAConfig config;
-    std::mt19937 rng;
 
-    std::vector<Individual> populacao;
+    // contextos[0] é o fluxo principal (inicialização e modo sequencial);
+    // com várias threads, o bloco b de filhos usa sempre contextos[b]
+    std::vector<ContextoTrabalhador> contextos;
+    std::unique_ptr<PoolThreads> pool;
+
+    // Vizinhos candidatos da busca local (vazio fora do modo memético)
+    ListaVizinhos vizinhos;
+
+    // Buffers duplos da população; ordem guarda índices ordenados por fitness
+    Populacao<Gene> populacao;
+    Populacao<Gene> proxima;
+    std::vector<int> ordem;
+
+    // Seleção proporcional: pesos e tabela de alias refeitos uma vez por
+    // geração (só leitura na fase paralela); no SUS, sorteados[2k] e
+    // sorteados[2k+1] são os pais do filho k
+    std::vector<double> pesos;
+    TabelaAlias roleta;
+    std::vector<int> sorteados;
+
+    // Hash de rotas e cache de fitness da população atual (refeito a cada
+    // geração, só leitura na fase paralela)
+    HashRotas hash_rotas;
+    CacheFitness cache;
+    static constexpr int TENTATIVAS_DUPLICATA = 3;
+
+    // Laço de geração de filhos da combinação de operadores configurada
+    using GeradorFilhos = void (GeneticAlgorithm::*)(ContextoTrabalhador &, int, int);
+    GeradorFilhos gerar_filhos;
+
     std::vector<double> melhor_por_epoca;
     std::vector<double> media_por_epoca;
     std::vector<double> pior_por_epoca;
+    std::vector<double> desvio_por_epoca;
+    std::vector<double> mediana_por_epoca;
+
+    // Estatísticas da população atual (recalculadas a cada geração)
+    EstatisticasGeracao estatisticas;
+    std::vector<double> trabalho_estatisticas;
 
     Individual melhor_todos;
     int generations_without_improvement;
+    uint32_t epoca = 0; // gerações já evoluídas; posiciona os fluxos aleatórios
+
+#ifdef TSP_PERFIL
+    // Fases do fluxo principal na época corrente e histórico consolidado
+    ContadoresFase perfil_principal;
+    std::vector<ContadoresFase> perfil_por_epoca;
+#endif
 
 public:
     GeneticAlgorithm(const InstanciaTSP &tsp_instance, const GAConfig &cfg)
-        : tsp(tsp_instance), config(cfg), rng(cfg.seed),
-          generations_without_improvement(0) {}
+        : tsp(tsp_instance), config(cfg),
+          contextos(std::max(1, cfg.num_threads)),
+          gerar_filhos(geradorFilhos(cfg)),
+          generations_without_improvement(0)
+    {
+        // Todos os trabalhadores usam a mesma chave; o fluxo é posicionado
+        // por filho (ver FluxoAleatorio)
+        for (auto &ctx : contextos)
+            ctx.rng.semear(static_cast<uint32_t>(cfg.seed));
+        if (contextos.size() > 1)
+        {
+            pool = std::make_unique<PoolThreads>(static_cast<int>(contextos.size()));
+        }
+        if (config.busca_local != GAConfig::SEM_BUSCA || config.crossover == GAConfig::EAX)
+        {
+            vizinhos = tsp.listasVizinhos(config.vizinhos_busca);
+        }
+        for (auto &ctx : contextos)
+        {
+            if (config.busca_local != GAConfig::SEM_BUSCA)
+            {
+                if (tsp.getSize() >= MIN_PONTOS_DUAS_CAMADAS)
+                    ctx.busca_local_camadas = std::make_unique<BuscaLocal<TourDuasCamadas>>(tsp, vizinhos);
+                else
+                    ctx.busca_local = std::make_unique<BuscaLocal<TourArray>>(tsp, vizinhos);
+            }
+            if (config.crossover == GAConfig::EAX)
+                ctx.eax = std::make_unique<CruzamentoEAX>(tsp, vizinhos);
+        }
+        if (usaHash())
+        {
+            hash_rotas.inicializar(tsp.getSize());
+        }
+    }
+
+    bool usaHash() const { return config.cache_fitness || config.duplicatas != GAConfig::PERMITIR; }
+
+    // Recalcula o hash da rota i de pop (se o GA usa hash de rotas)
+    void atualizarHash(Populacao<Gene> &pop, int i)
+    {
+        if (usaHash())
+            pop.hash[i] = hash_rotas.hash(pop.rota(i), pop.n);
+    }
+
+    GeneticAlgorithm(const GeneticAlgorithm &) = delete;
+    GeneticAlgorithm &operator=(const GeneticAlgorithm &) = delete;
+
+    // Rota heurística para o i-ésimo indivíduo semeado
+    // Vizinho mais próximo parte de um ponto sorteado; guloso e Hilbert são
+    // determinísticos, então cada cópia além da primeira recebe um double-bridge
+    Rota rotaSemeada(int i, const ListaVizinhos &lista, Rota &gulosa, Rota &hilbert)
+    {
+        GeradorPhilox &rng = contextos[0].rng;
+        GAConfig::SemeaduraType tipo = config.semeadura;
+        if (tipo == GAConfig::MISTA)
+        {
+            static const GAConfig::SemeaduraType ciclo[] = {
+                GAConfig::VIZINHO_MAIS_PROXIMO, GAConfig::GULOSA, GAConfig::HILBERT};
+            tipo = ciclo[i % 3];
+        }
+
+        Rota rota;
+        switch (tipo)
+        {
+        case GAConfig::VIZINHO_MAIS_PROXIMO:
+            return rotaVizinhoMaisProximo(tsp, lista, rng.inteiro(0, tsp.getSize() - 1));
+        case GAConfig::GULOSA:
+            if (gulosa.empty())
+            {
+                gulosa = rotaGulosa(tsp, lista);
+                return gulosa;
+            }
+            rota = gulosa;
+            break;
+        default:
+            if (hilbert.empty())
+            {
+                hilbert = rotaHilbert(tsp);
+                return hilbert;
+            }
+            rota = hilbert;
+            break;
+        }
+        perturbarDuploPonte(rota, rng);
+        return rota;
+    }
 
-    // Inicializa população com rotas aleatórias
+    // Dimensiona população, buffers de trabalho e histórico
+    void alocarEstruturas()
+    {
+        int n = tsp.getSize();
+        populacao.redimensionar(config.tam_populacao, n);
+        proxima.redimensionar(config.tam_populacao, n);
+        ordem.resize(config.tam_populacao);
+        std::iota(ordem.begin(), ordem.end(), 0);
+        pesos.resize(config.tam_populacao);
+        sorteados.resize(2 * static_cast<size_t>(config.tam_populacao));
+
+        // Histórico pré-alocado: o laço de gerações não aloca memória
+        melhor_por_epoca.reserve(config.num_epocas);
+        media_por_epoca.reserve(config.num_epocas);
+        pior_por_epoca.reserve(config.num_epocas);
+        desvio_por_epoca.reserve(config.num_epocas);
+        mediana_por_epoca.reserve(config.num_epocas);
+#ifdef TSP_PERFIL
+        perfil_por_epoca.reserve(config.num_epocas);
+#endif
+        trabalho_estatisticas.reserve(config.tam_populacao);
+    }
+
+    // Inicializa população com rotas aleatórias e, se configurado, heurísticas
     void initPop()
     {
-        populacao.clear();
-        populacao.reserve(config.tam_populacao);
+        alocarEstruturas();
+
+        int num_semeados = 0;
+        ListaVizinhos lista_local;
+        const ListaVizinhos *lista = &vizinhos;
+        if (config.semeadura != GAConfig::ALEATORIA)
+        {
+            num_semeados = static_cast<int>(std::lround(config.fracao_semeada * config.tam_populacao));
+            if (vizinhos.k == 0)
+            {
+                lista_local = tsp.listasVizinhos(10);
+                lista = &lista_local;
+            }
+        }
 
+        Rota gulosa, hilbert;
         for (int i = 0; i < config.tam_populacao; ++i)
         {
-            Rota rota = tsp.randomRota(rng);
-            double fitness = tsp.compRota(rota);
-            populacao.emplace_back(rota, fitness);
+            contextos[0].rng.posicionar(FLUXO_INICIAL, 0, i);
+            Rota rota = i < num_semeados ? rotaSemeada(i, *lista, gulosa, hilbert)
+                                         : tsp.randomRota(contextos[0].rng);
+            populacao.definir(i, rota, 0.0);
+            atualizarHash(populacao, i);
         }
+        tsp.compRotas(populacao.genes.data(), populacao.n, populacao.tam, populacao.fitness.data());
 
         // Encontra o melhor inicial (com validação)
-        if (!populacao.empty())
+        estatisticas = calcularEstatisticas(populacao.fitness.data(), populacao.tam, trabalho_estatisticas);
+        if (populacao.tam > 0)
         {
-            melhor_todos = *std::min_element(populacao.begin(), populacao.end());
+            melhor_todos = populacao.individuo(estatisticas.indice_melhor);
         }
     }
 
     // Seleção por torneio
-    // Seleciona k indivíduos aleatórios e retorna o melhor
-    Individual selecaoTorneio()
+    // Sorteia k índices e devolve o de menor fitness (nenhuma rota é copiada)
+    int selecaoTorneio(ContextoTrabalhador &ctx) const
     {
-        std::uniform_int_distribution<int> dist(0, populacao.size() - 1);
+        uint32_t tam = static_cast<uint32_t>(populacao.tam);
 
-        Individual melhor = populacao[dist(rng)];
+        int melhor = static_cast<int>(ctx.rng.abaixoDe(tam));
         for (int i = 1; i < config.tam_torneio; ++i)
         {
-            Individual candidate = populacao[dist(rng)];
-            if (candidate.fitness < melhor.fitness)
+            int candidate = static_cast<int>(ctx.rng.abaixoDe(tam));
+            if (populacao.fitness[candidate] < populacao.fitness[melhor])
             {
                 melhor = candidate;
             }
@@ -109,191 +481,535 @@ public:
         return melhor;
     }
 
-    // Seleção por roleta (proporcional à fitness)
-    // Para TSP (minimização), usa fitness inversa
-    Individual selecaoRoleta()
+    // Pesos da roleta: fitness inversa para minimização (pior - fitness + 1)
+    void pesosRoleta()
     {
-        // Calcula fitness inversa (já que minimizamos a distância)
-        std::vector<double> inverse_fitness(populacao.size());
-        double max_fitness = std::max_element(populacao.begin(), populacao.end())->fitness;
-        double total = 0.0;
-
-        for (size_t i = 0; i < populacao.size(); ++i)
+        const std::vector<double> &fit = populacao.fitness;
+        double max_fitness = *std::max_element(fit.begin(), fit.end());
+        for (int i = 0; i < populacao.tam; ++i)
         {
-            // Inverse fitness: max - fitness + 1 (evita valores negativos)
-            inverse_fitness[i] = max_fitness - populacao[i].fitness + 1.0;
-            total += inverse_fitness[i];
+            pesos[i] = max_fitness - fit[i] + 1.0;
         }
+    }
 
-        // Gira a roleta
-        std::uniform_real_distribution<double> dist(0.0, total);
-        double spin = dist(rng);
-        double cumulative = 0.0;
+    // Pesos do ranking linear: o melhor recebe s/N e o pior (2-s)/N
+    // Requer ordem já ordenada por fitness
+    void pesosRanking()
+    {
+        int tam = populacao.tam;
+        double s = std::min(2.0, std::max(1.0, config.pressao_ranking));
+        for (int r = 0; r < tam; ++r)
+        {
+            double w = tam > 1 ? (2.0 - s) + 2.0 * (s - 1.0) * (tam - 1 - r) / (tam - 1) : 1.0;
+            pesos[ordem[r]] = w / tam;
+        }
+    }
 
-        for (size_t i = 0; i < populacao.size(); ++i)
+    // Prepara a seleção da geração (antes da fase paralela, no fluxo principal)
+    // Requer ordem já ordenada por fitness
+    void prepararSelecao(int num_elite)
+    {
+        switch (config.selection)
         {
-            cumulative += inverse_fitness[i];
-            if (cumulative >= spin)
-            {
-                return populacao[i];
-            }
+        case GAConfig::ROLETA:
+            pesosRoleta();
+            roleta.construir(pesos.data(), populacao.tam);
+            break;
+        case GAConfig::RANKING:
+            pesosRanking();
+            roleta.construir(pesos.data(), populacao.tam);
+            break;
+        case GAConfig::SUS:
+        {
+            // O SUS devolve os pais em ordem de índice; embaralha para
+            // formar os pares
+            int m = 2 * (populacao.tam - num_elite);
+            if (m <= 0)
+                break;
+            int *saida = sorteados.data() + 2 * num_elite;
+            pesosRoleta();
+            contextos[0].rng.posicionar(FLUXO_SELECAO, epoca, 0);
+            amostragemUniversal(pesos.data(), populacao.tam, m, contextos[0].rng, saida);
+            embaralhar(saida, saida + m, contextos[0].rng);
+            break;
+        }
+        default:
+            break;
         }
-        return populacao.back();
     }
 
-    // Seleciona pai com base no método de seleção configurado
-    Individual selecaoParente()
+    // Seleção por roleta ou ranking: sorteio O(1) na tabela de alias da geração
+    int selecaoRoleta(ContextoTrabalhador &ctx) const
     {
-        if (config.selection == GAConfig::TORNEIO)
+        return roleta.sortear(ctx.rng);
+    }
+
+    // Pais do filho k pela política de seleção S, fixada em compilação
+    // (ROLETA e RANKING sorteiam na mesma tabela de alias)
+    template <GAConfig::SelectionType S>
+    void escolherPais(ContextoTrabalhador &ctx, int k, int &parente1, int &parente2) const
+    {
+        if constexpr (S == GAConfig::SUS)
+        {
+            parente1 = sorteados[2 * k];
+            parente2 = sorteados[2 * k + 1];
+        }
+        else if constexpr (S == GAConfig::TORNEIO)
         {
-            return selecaoTorneio();
+            parente1 = selecaoTorneio(ctx);
+            parente2 = selecaoTorneio(ctx);
         }
         else
         {
-            return selecaoRoleta();
+            parente1 = selecaoRoleta(ctx);
+            parente2 = selecaoRoleta(ctx);
         }
     }
 
     // Crossover Ordenado (OX)
     // Preserva a ordem relativa das pontos de um pai
-    Rota crossoverOrdenado(const Rota &parente1, const Rota &parente2)
+    // Pertinência ao filho via buffer com carimbo de geração: O(n), sem alocação
+    template <typename G>
+    void crossoverOrdenado(const G *parente1, const G *parente2, G *child, int n,
+                           ContextoTrabalhador &ctx)
     {
-        int n = parente1.size();
-        std::uniform_int_distribution<int> dist(0, n - 1);
-
-        int start = dist(rng);
-        int end = dist(rng);
-        if (start > end)
-            std::swap(start, end);
+        int pos[2];
+        ctx.rng.inteiros(static_cast<uint32_t>(n), pos, 2);
+        int start = std::min(pos[0], pos[1]);
+        int end = std::max(pos[0], pos[1]);
 
-        Rota child(n, -1);
+        unsigned carimbo = ctx.novoCarimbo(n);
 
         // Copia segmento do parente1
         for (int i = start; i <= end; ++i)
         {
             child[i] = parente1[i];
+            ctx.marca[parente1[i]] = carimbo;
         }
 
         // Preenche posições restantes com pontos do parente2 em ordem
         int child_pos = (end + 1) % n;
+        int parente2_pos = (end + 1) % n;
         for (int i = 0; i < n; ++i)
         {
-            int parente2_pos = (end + 1 + i) % n;
             int pto = parente2[parente2_pos];
+            if (++parente2_pos == n)
+                parente2_pos = 0;
 
-            // Verifica se a ponto já está no filho (em TODO o vetor)
-            bool found = std::find(child.begin(), child.end(), pto) != child.end();
-
-            if (!found)
+            if (ctx.marca[pto] != carimbo)
             {
                 child[child_pos] = pto;
-                child_pos = (child_pos + 1) % n;
+                if (++child_pos == n)
+                    child_pos = 0;
             }
         }
-
-        return child;
     }
 
     // Crossover Mapeado Parcialmente (PMX)
-    // Mapeia um segmento entre parentes e preenche o resto
-    Rota crossoverParcialmenteMapeado(const Rota &parente1, const Rota &parente2)
+    // O filho recebe o segmento do parente2; fora dele herda o parente1,
+    // seguindo o mapeamento parente2[i] -> parente1[i] para evitar repetições
+    template <typename G>
+    void crossoverParcialmenteMapeado(const G *parente1, const G *parente2, G *child, int n,
+                                      ContextoTrabalhador &ctx)
     {
-        int n = parente1.size();
-        std::uniform_int_distribution<int> dist(0, n - 1);
-
-        int start = dist(rng);
-        int end = dist(rng);
-        if (start > end)
-            std::swap(start, end);
+        int pos[2];
+        ctx.rng.inteiros(static_cast<uint32_t>(n), pos, 2);
+        int start = std::min(pos[0], pos[1]);
+        int end = std::max(pos[0], pos[1]);
 
-        Rota child = parente1;
+        unsigned carimbo = ctx.novoCarimbo(n);
 
-        // Cria mapeamento do segmento parente1 para parente2
-        std::vector<int> mapeamento(n, -1);
+        // Segmento do parente2 e mapeamento para o parente1 (válido se marca == carimbo)
         for (int i = start; i <= end; ++i)
         {
-            mapeamento[parente1[i]] = parente2[i];
-            child[i] = parente2[i];
+            int pto = parente2[i];
+            child[i] = pto;
+            ctx.marca[pto] = carimbo;
+            ctx.mapeamento[pto] = parente1[i];
         }
 
         // Preenche posições fora do segmento
         for (int i = 0; i < n; ++i)
         {
-            if (i >= start && i <= end)
+            if (i == start)
+            {
+                i = end;
                 continue;
+            }
 
             int pto = parente1[i];
-            // Segue a cadeia de mapeamento até encontrar uma ponto não no segmento
-            while (mapeamento[pto] != -1)
+            // Segue a cadeia de mapeamento até encontrar um ponto fora do segmento
+            while (ctx.marca[pto] == carimbo)
             {
-                pto = mapeamento[pto];
+                pto = ctx.mapeamento[pto];
             }
             child[i] = pto;
         }
+    }
+
+    // Crossover pela política C, fixada em compilação
+    template <GAConfig::CrossoverType C, typename G>
+    void cruzar(const G *parente1, const G *parente2, G *child, int n, ContextoTrabalhador &ctx)
+    {
+        if constexpr (C == GAConfig::OX)
+            crossoverOrdenado(parente1, parente2, child, n, ctx);
+        else if constexpr (C == GAConfig::PMX)
+            crossoverParcialmenteMapeado(parente1, parente2, child, n, ctx);
+        else if constexpr (C == GAConfig::ERX)
+            ctx.erx.cruzar(parente1, parente2, child, n, ctx.rng);
+        else
+            ctx.eax->cruzar(parente1, parente2, child, n, ctx.rng);
+    }
 
-        return child;
+    // Atalhos com Rota (genes int) no fluxo principal (contextos[0])
+    void crossoverOrdenado(const Rota &parente1, const Rota &parente2, Rota &child)
+    {
+        child.resize(parente1.size());
+        crossoverOrdenado(parente1.data(), parente2.data(), child.data(),
+                          static_cast<int>(parente1.size()), contextos[0]);
+    }
+    void crossoverParcialmenteMapeado(const Rota &parente1, const Rota &parente2, Rota &child)
+    {
+        child.resize(parente1.size());
+        crossoverParcialmenteMapeado(parente1.data(), parente2.data(), child.data(),
+                                     static_cast<int>(parente1.size()), contextos[0]);
+    }
+    template <GAConfig::MutationType M>
+    void mutar(Rota &rota, double &fitness)
+    {
+        mutar<M>(rota.data(), static_cast<int>(rota.size()), fitness, contextos[0]);
+    }
+    template <GAConfig::SelectionType S>
+    void escolherPais(int k, int &parente1, int &parente2)
+    {
+        escolherPais<S>(contextos[0], k, parente1, parente2);
     }
 
-    // Crossover baseado no tipo configurado
-    Rota crossover(const Rota &parente1, const Rota &parente2)
+    // Mutação pela política M (troca, inversão ou inserção), fixada em compilação
+    // A fitness é atualizada pelo delta das arestas afetadas, sem recalcular a rota
+    template <GAConfig::MutationType M, typename G>
+    void mutar(G *rota, int n, double &fitness, ContextoTrabalhador &ctx)
     {
-        if (config.crossover == GAConfig::OX)
+        int pos[2];
+        ctx.rng.inteiros(static_cast<uint32_t>(n), pos, 2);
+        int pos1 = pos[0];
+        int pos2 = pos[1];
+
+        if constexpr (M == GAConfig::INVERSAO)
+        {
+            if (pos1 > pos2)
+                std::swap(pos1, pos2);
+            fitness += deltaInversao(tsp, rota, n, pos1, pos2);
+            aplicarInversao(rota, pos1, pos2);
+        }
+        else if constexpr (M == GAConfig::INSERCAO)
         {
-            return crossoverOrdenado(parente1, parente2);
+            fitness += deltaInsercao(tsp, rota, n, pos1, pos2);
+            aplicarInsercao(rota, n, pos1, pos2);
         }
         else
         {
-            return crossoverParcialmenteMapeado(parente1, parente2);
+            fitness += deltaTroca(tsp, rota, n, pos1, pos2);
+            aplicarTroca(rota, pos1, pos2);
         }
     }
 
-    // Mutação por troca: troca duas posições aleatórias
-    void mutate(Rota &rota)
+    // Mutação com probabilidade taxa_mutacao, dado o sorteio em [0, 1);
+    // devolve true se foi aplicada
+    template <GAConfig::MutationType M, typename G>
+    bool mutarComTaxa(G *rota, int n, double &fitness, ContextoTrabalhador &ctx, double sorteio)
     {
-        std::uniform_real_distribution<double> prob_dist(0.0, 1.0);
+        if (sorteio < config.taxa_mutacao)
+        {
+            mutar<M>(rota, n, fitness, ctx);
+            return true;
+        }
+        return false;
+    }
 
-        if (prob_dist(rng) < config.taxa_mutacao)
+    // Busca local com a estrutura de rota escolhida na construção
+    template <typename G>
+    void melhorarRota(G *rota, int n, double &fitness, ContextoTrabalhador &ctx)
+    {
+        if (ctx.busca_local_camadas)
+            ctx.busca_local_camadas->melhorar(rota, n, fitness);
+        else
+            ctx.busca_local->melhorar(rota, n, fitness);
+    }
+
+    // Produz o filho k da próxima população: seleção, cruzamento, mutação e avaliação
+    // Trabalha direto nas linhas dos buffers, sem copiar nem alocar rotas
+    template <GAConfig::SelectionType S, GAConfig::CrossoverType C, GAConfig::MutationType M>
+    void produzirFilho(ContextoTrabalhador &ctx, int k)
+    {
+        int n = populacao.n;
+        // Sorteios de cruzamento, mutação e busca local num lote só
+        double moedas[3];
+        ctx.rng.reais(moedas, 3);
+        int parente1, parente2;
+        {
+            PERFIL_FASE(ctx.perfil, FasePerfil::SELECAO);
+            escolherPais<S>(ctx, k, parente1, parente2);
+        }
+        Gene *filho = proxima.rota(k);
+        double &fitness = proxima.fitness[k];
+
+        if (moedas[0] < config.taxa_cruzamento)
+        {
+            {
+                PERFIL_FASE(ctx.perfil, FasePerfil::CRUZAMENTO);
+                cruzar<C>(populacao.rota(parente1), populacao.rota(parente2), filho, n, ctx);
+            }
+            PERFIL_FASE(ctx.perfil, FasePerfil::AVALIACAO);
+            if (usaHash())
+            {
+                proxima.hash[k] = hash_rotas.hash(filho, n);
+                if (config.cache_fitness && cache.buscar(proxima.hash[k], fitness))
+                    ctx.avaliacoes_poupadas++;
+                else
+                    fitness = tsp.compRota(filho, n);
+            }
+            else
+            {
+                fitness = tsp.compRota(filho, n);
+            }
+        }
+        else
+        {
+            proxima.copiar(k, populacao, parente1);
+        }
+        bool alterado;
+        {
+            PERFIL_FASE(ctx.perfil, FasePerfil::MUTACAO);
+            alterado = mutarComTaxa<M>(filho, n, fitness, ctx, moedas[1]);
+        }
+
+        if (config.busca_local == GAConfig::BUSCA_TODOS ||
+            (config.busca_local == GAConfig::BUSCA_AMOSTRA && moedas[2] < config.taxa_busca_local))
         {
-            std::uniform_int_distribution<int> pos_dist(0, rota.size() - 1);
-            int pos1 = pos_dist(rng);
-            int pos2 = pos_dist(rng);
-            std::swap(rota[pos1], rota[pos2]);
+            PERFIL_FASE(ctx.perfil, FasePerfil::BUSCA_LOCAL);
+            melhorarRota(filho, n, fitness, ctx);
+            alterado = true;
         }
+        if (alterado)
+            atualizarHash(proxima, k);
     }
 
-    // Evolui população por uma geração
-    void evoluir()
+    // Gera o filho k aplicando a política de substituição D (duplicatas): um
+    // filho com as mesmas arestas de uma rota da população atual é refeito ou
+    // mutado antes de entrar na próxima população
+    template <GAConfig::SelectionType S, GAConfig::CrossoverType C, GAConfig::MutationType M,
+              GAConfig::DuplicataType D>
+    void gerarFilho(ContextoTrabalhador &ctx, int k)
+    {
+        ctx.rng.posicionar(FLUXO_FILHO, epoca, k);
+        produzirFilho<S, C, M>(ctx, k);
+        if constexpr (D != GAConfig::PERMITIR)
+        {
+            for (int t = 0; t < TENTATIVAS_DUPLICATA && cache.contem(proxima.hash[k]); ++t)
+            {
+                ctx.duplicatas++;
+                if constexpr (D == GAConfig::REJEITAR)
+                {
+                    produzirFilho<S, C, M>(ctx, k);
+                }
+                else
+                {
+                    PERFIL_FASE(ctx.perfil, FasePerfil::MUTACAO);
+                    mutar<M>(proxima.rota(k), proxima.n, proxima.fitness[k], ctx);
+                    atualizarHash(proxima, k);
+                }
+            }
+        }
+    }
+
+    // Filhos [inicio, fim) da próxima população com o contexto dado: o laço
+    // interno de cada combinação de operadores. Seleção, cruzamento, mutação
+    // e duplicatas são fixados em compilação; taxa de cruzamento, hash/cache
+    // de fitness e modo da busca local continuam testes em tempo de execução
+    // (mesmo valor em todo filho, então previsíveis pelo processador)
+    template <GAConfig::SelectionType S, GAConfig::CrossoverType C, GAConfig::MutationType M,
+              GAConfig::DuplicataType D>
+    void gerarFilhos(ContextoTrabalhador &ctx, int inicio, int fim)
     {
-        std::vector<Individual> new_populacao;
-        new_populacao.reserve(config.tam_populacao);
+        for (int k = inicio; k < fim; ++k)
+            gerarFilho<S, C, M, D>(ctx, k);
+    }
 
-        // Elitismo: mantém os melhores indivíduos
-        std::sort(populacao.begin(), populacao.end());
-        for (int i = 0; i < config.quant_alpha && i < static_cast<int>(populacao.size()); ++i)
+    // Tabela de despacho: escolhe uma vez, no construtor, a instância de
+    // gerarFilhos da combinação configurada (seleção, cruzamento, mutação e
+    // duplicatas); evoluir() chama só o ponteiro resolvido
+    template <GAConfig::SelectionType S, GAConfig::CrossoverType C, GAConfig::MutationType M>
+    static GeradorFilhos geradorDuplicatas(const GAConfig &c)
+    {
+        switch (c.duplicatas)
         {
-            new_populacao.push_back(populacao[i]);
+        case GAConfig::REJEITAR:
+            return &GeneticAlgorithm::gerarFilhos<S, C, M, GAConfig::REJEITAR>;
+        case GAConfig::MUTAR:
+            return &GeneticAlgorithm::gerarFilhos<S, C, M, GAConfig::MUTAR>;
+        default:
+            return &GeneticAlgorithm::gerarFilhos<S, C, M, GAConfig::PERMITIR>;
         }
+    }
 
-        // Gera descendentes
-        while (new_populacao.size() < static_cast<size_t>(config.tam_populacao))
+    template <GAConfig::SelectionType S, GAConfig::CrossoverType C>
+    static GeradorFilhos geradorMutacao(const GAConfig &c)
+    {
+        switch (c.mutacao)
         {
-            Individual parente1 = selecaoParente();
-            Individual parente2 = selecaoParente();
+        case GAConfig::INVERSAO:
+            return geradorDuplicatas<S, C, GAConfig::INVERSAO>(c);
+        case GAConfig::INSERCAO:
+            return geradorDuplicatas<S, C, GAConfig::INSERCAO>(c);
+        default:
+            return geradorDuplicatas<S, C, GAConfig::TROCA>(c);
+        }
+    }
 
-            Rota child = crossover(parente1.rota, parente2.rota);
-            mutate(child);
+    template <GAConfig::SelectionType S>
+    static GeradorFilhos geradorCruzamento(const GAConfig &c)
+    {
+        switch (c.crossover)
+        {
+        case GAConfig::PMX:
+            return geradorMutacao<S, GAConfig::PMX>(c);
+        case GAConfig::ERX:
+            return geradorMutacao<S, GAConfig::ERX>(c);
+        case GAConfig::EAX:
+            return geradorMutacao<S, GAConfig::EAX>(c);
+        default:
+            return geradorMutacao<S, GAConfig::OX>(c);
+        }
+    }
 
-            double fitness = tsp.compRota(child);
-            new_populacao.emplace_back(child, fitness);
+    static GeradorFilhos geradorFilhos(const GAConfig &c)
+    {
+        switch (c.selection)
+        {
+        case GAConfig::TORNEIO:
+            return geradorCruzamento<GAConfig::TORNEIO>(c);
+        case GAConfig::SUS:
+            return geradorCruzamento<GAConfig::SUS>(c);
+        default:
+            return geradorCruzamento<GAConfig::ROLETA>(c); // roleta e ranking
         }
+    }
+
+    // Ordena os índices da população atual por fitness (melhor primeiro)
+    void ordenarIndices()
+    {
+        std::iota(ordem.begin(), ordem.end(), 0);
+        const std::vector<double> &fit = populacao.fitness;
+        std::sort(ordem.begin(), ordem.end(), [&](int a, int b)
+                  { return fit[a] < fit[b]; });
+    }
+
+    // Coloca em ordem[0, m) os índices dos m melhores, ordenados;
+    // o resto de ordem fica sem ordem definida. O(tam log m)
+    void selecionarMelhores(int m)
+    {
+        std::iota(ordem.begin(), ordem.end(), 0);
+        const std::vector<double> &fit = populacao.fitness;
+        std::partial_sort(ordem.begin(), ordem.begin() + m, ordem.end(), [&](int a, int b)
+                          { return fit[a] < fit[b]; });
+    }
+
+    // Busca local nos melhores filhos recém-gerados (modo BUSCA_ELITE)
+    // Usa ordem como espaço de trabalho para os índices dos filhos
+    void buscaLocalElite(int num_elite)
+    {
+        int num_filhos = proxima.tam - num_elite;
+        int m = std::min(std::max(1, config.quant_alpha), num_filhos);
+        if (m <= 0)
+            return;
+
+        std::iota(ordem.begin(), ordem.begin() + num_filhos, num_elite);
+        const std::vector<double> &fit = proxima.fitness;
+        std::nth_element(ordem.begin(), ordem.begin() + m - 1, ordem.begin() + num_filhos,
+                         [&](int a, int b)
+                         { return fit[a] < fit[b]; });
+
+        int blocos = static_cast<int>(contextos.size());
+        auto melhorarBloco = [&](int b)
+        {
+            for (int i = b; i < m; i += blocos)
+            {
+                int k = ordem[i];
+                PERFIL_FASE(contextos[b].perfil, FasePerfil::BUSCA_LOCAL);
+                melhorarRota(proxima.rota(k), proxima.n, proxima.fitness[k], contextos[b]);
+                atualizarHash(proxima, k);
+            }
+        };
+        if (pool)
+            pool->executar(blocos, melhorarBloco);
+        else
+            melhorarBloco(0);
+    }
 
-        populacao = std::move(new_populacao);
+    // Evolui população por uma geração (sem alocação: escreve em proxima e troca)
+    void evoluir()
+    {
+        PERFIL_FASE(perfil_principal, FasePerfil::EPOCA);
+        ++epoca;
+
+        // Elitismo: mantém os melhores indivíduos (o ranking precisa da ordem completa)
+        int num_elite = std::min(config.quant_alpha, populacao.tam);
+        {
+            PERFIL_FASE(perfil_principal, FasePerfil::ELITISMO);
+            if (config.selection == GAConfig::RANKING)
+                ordenarIndices();
+            else
+                selecionarMelhores(num_elite);
+            for (int i = 0; i < num_elite; ++i)
+            {
+                proxima.copiar(i, populacao, ordem[i]);
+            }
+        }
+        {
+            PERFIL_FASE(perfil_principal, FasePerfil::SELECAO);
+            prepararSelecao(num_elite);
+        }
+        if (usaHash())
+        {
+            PERFIL_FASE(perfil_principal, FasePerfil::AVALIACAO);
+            cache.construir(populacao.hash.data(), populacao.fitness.data(), populacao.tam);
+        }
 
-        // Atualiza o melhor de todos
-        Individual current_best = *std::min_element(populacao.begin(), populacao.end());
-        if (current_best.fitness < melhor_todos.fitness)
+        // Gera descendentes; em paralelo, cada bloco contíguo de filhos
+        // usa o contexto do mesmo índice, independente de qual thread o executa
+        int num_filhos = populacao.tam - num_elite;
+        if (pool)
         {
-            melhor_todos = current_best;
+            int blocos = static_cast<int>(contextos.size());
+            auto gerarBloco = [&](int b)
+            {
+                int inicio = num_elite + static_cast<int>(static_cast<long>(num_filhos) * b / blocos);
+                int fim = num_elite + static_cast<int>(static_cast<long>(num_filhos) * (b + 1) / blocos);
+                (this->*gerar_filhos)(contextos[b], inicio, fim);
+            };
+            pool->executar(blocos, gerarBloco);
+        }
+        else
+        {
+            (this->*gerar_filhos)(contextos[0], num_elite, populacao.tam);
+        }
+
+        if (config.busca_local == GAConfig::BUSCA_ELITE)
+        {
+            buscaLocalElite(num_elite);
+        }
+
+        populacao.trocar(proxima);
+
+        // Atualiza estatísticas e o melhor de todos (assign reaproveita a capacidade da rota)
+        PERFIL_FASE(perfil_principal, FasePerfil::ESTATISTICAS);
+        estatisticas = calcularEstatisticas(populacao.fitness.data(), populacao.tam, trabalho_estatisticas);
+        int current_best = estatisticas.indice_melhor;
+        if (populacao.fitness[current_best] < melhor_todos.fitness)
+        {
+            melhor_todos.rota.assign(populacao.rota(current_best), populacao.rota(current_best) + populacao.n);
+            melhor_todos.fitness = populacao.fitness[current_best];
             generations_without_improvement = 0;
         }
         else
@@ -302,37 +1018,227 @@ public:
         }
     }
 
-    // Executa GA pelas épocas configuradas
-    void run()
+    // Registra as estatísticas da população atual no histórico
+    // (calculadas no fim de evoluir, sem ordenar a população)
+    void registrarEstatisticas()
     {
-        initPop();
+        melhor_por_epoca.push_back(estatisticas.melhor);
+        media_por_epoca.push_back(estatisticas.media);
+        pior_por_epoca.push_back(estatisticas.pior);
+        desvio_por_epoca.push_back(estatisticas.desvio);
+        mediana_por_epoca.push_back(estatisticas.mediana);
+    }
 
-        for (int epocas = 0; epocas < config.num_epocas; ++epocas)
+    // Uma época completa: evolução seguida do registro de estatísticas
+    void passo()
+    {
+        evoluir();
+        registrarEstatisticas();
+#ifdef TSP_PERFIL
+        consolidarPerfil();
+#endif
+    }
+
+#ifdef TSP_PERFIL
+    // Junta os contadores do fluxo principal e dos trabalhadores numa linha
+    // do histórico e os zera para a próxima época
+    void consolidarPerfil()
+    {
+        ContadoresFase epoca = perfil_principal;
+        perfil_principal.zerar();
+        for (auto &ctx : contextos)
+        {
+            epoca.somar(ctx.perfil);
+            ctx.perfil.zerar();
+        }
+        perfil_por_epoca.push_back(epoca);
+    }
+
+    const std::vector<ContadoresFase> &getPerfilPorEpoca() const { return perfil_por_epoca; }
+
+    // Contadores da última época registrada (fases medidas fora do GA, ex.: quadros)
+    ContadoresFase &perfilUltimaEpoca() { return perfil_por_epoca.back(); }
+#endif
+
+    // Verifica paciência (parada antecipada)
+    bool pacienciaEsgotada() const
+    {
+        return generations_without_improvement >= config.paciencia;
+    }
+
+    // Cópias dos k melhores indivíduos da população atual (emigrantes)
+    std::vector<Individual> melhores(int k)
+    {
+        k = std::min(k, populacao.tam);
+        selecionarMelhores(k);
+        std::vector<Individual> saida;
+        saida.reserve(k);
+        for (int i = 0; i < k; ++i)
         {
-            evoluir();
+            saida.push_back(populacao.individuo(ordem[i]));
+        }
+        return saida;
+    }
+
+    // Recebe imigrantes no lugar dos piores indivíduos (a elite é preservada)
+    void receberMigrantes(const std::vector<Individual> &migrantes)
+    {
+        int vagas = populacao.tam - std::min(config.quant_alpha, populacao.tam);
+        int k = std::min(static_cast<int>(migrantes.size()), vagas);
+        if (k <= 0)
+            return;
 
-            // Rastreia estatísticas
-            std::sort(populacao.begin(), populacao.end());
-            double melhor = populacao[0].fitness;
-            double pior = populacao.back().fitness;
-            double soma = 0.0;
-            for (const auto &ind : populacao)
+        // Os k piores vão para o final de ordem e são substituídos
+        std::iota(ordem.begin(), ordem.end(), 0);
+        const std::vector<double> &fit = populacao.fitness;
+        std::nth_element(ordem.begin(), ordem.begin() + (populacao.tam - k), ordem.end(), [&](int a, int b)
+                         { return fit[a] < fit[b]; });
+        for (int i = 0; i < k; ++i)
+        {
+            populacao.definir(ordem[populacao.tam - k + i], migrantes[i].rota, migrantes[i].fitness);
+            atualizarHash(populacao, ordem[populacao.tam - k + i]);
+            if (migrantes[i].fitness < melhor_todos.fitness)
             {
-                soma += ind.fitness;
+                melhor_todos = migrantes[i];
+                generations_without_improvement = 0;
             }
-            double media = soma / populacao.size();
+        }
+    }
 
-            melhor_por_epoca.push_back(melhor);
-            media_por_epoca.push_back(media);
-            pior_por_epoca.push_back(pior);
+    // Impressão digital dos parâmetros que afetam a evolução: todos menos
+    // num_threads e os critérios de parada num_epocas e paciencia, que podem
+    // crescer ao retomar (a seed é conferida à parte)
+    uint64_t assinaturaConfig() const
+    {
+        std::vector<char> dados;
+        auto campo = [&](const auto &v)
+        {
+            const char *c = reinterpret_cast<const char *>(&v);
+            dados.insert(dados.end(), c, c + sizeof(v));
+        };
+        campo(config.tam_populacao);
+        campo(config.taxa_mutacao);
+        campo(config.tam_torneio);
+        campo(config.quant_alpha);
+        campo(config.selection);
+        campo(config.pressao_ranking);
+        campo(config.crossover);
+        campo(config.mutacao);
+        campo(config.taxa_cruzamento);
+        campo(config.busca_local);
+        campo(config.taxa_busca_local);
+        campo(config.vizinhos_busca);
+        campo(config.semeadura);
+        campo(config.fracao_semeada);
+        campo(config.cache_fitness);
+        campo(config.duplicatas);
+        return hashFNV1a(dados.data(), dados.size());
+    }
 
-            // Verifica paciência (parada antecipada)
-            if (generations_without_improvement >= config.paciencia)
+    // Checkpoint binário do estado completo: população, melhor de todos,
+    // histórico, paciência, seed e época. Os sorteios dependem só da seed e da
+    // época, então retomar com a mesma configuração, com qualquer número de
+    // threads, continua a execução bit a bit.
+    bool salvarCheckpoint(const std::string &caminho, std::string &erro) const
+    {
+        EscritorBinario out;
+        out.valor(static_cast<int32_t>(sizeof(Gene)));
+        out.valor(static_cast<int32_t>(populacao.n));
+        out.valor(static_cast<int32_t>(populacao.tam));
+        out.valor(static_cast<int32_t>(config.seed));
+        out.valor(assinaturaConfig());
+        out.valor(epoca);
+        out.valor(static_cast<int32_t>(generations_without_improvement));
+        out.vetor(populacao.genes.data(), populacao.genes.size());
+        out.vetor(populacao.fitness.data(), populacao.fitness.size());
+        out.vetor(melhor_todos.rota);
+        out.valor(melhor_todos.fitness);
+        for (const auto *historico : {&melhor_por_epoca, &media_por_epoca, &pior_por_epoca,
+                                      &desvio_por_epoca, &mediana_por_epoca})
+            out.vetor(*historico);
+        return gravarArquivoAtomico(caminho, out.finalizar(), erro);
+    }
+
+    // Substitui initPop() ao retomar; falha se o checkpoint não casar com a
+    // instância e a configuração atuais
+    bool carregarCheckpoint(const std::string &caminho, std::string &erro)
+    {
+        std::vector<char> buffer;
+        LeitorBinario in;
+        if (!lerArquivoBinario(caminho, buffer, erro) || !in.abrir(buffer, erro))
+            return false;
+
+        int32_t largura_gene, n, tam, seed, sem_melhora;
+        uint64_t assinatura;
+        uint32_t epoca_salva;
+        if (!in.valor(largura_gene) || !in.valor(n) || !in.valor(tam) || !in.valor(seed) ||
+            !in.valor(assinatura) || !in.valor(epoca_salva) || !in.valor(sem_melhora))
+        {
+            erro = "checkpoint truncado";
+            return false;
+        }
+        if (n != tsp.getSize() || tam != config.tam_populacao)
+        {
+            erro = "checkpoint de outra instância ou população (n=" + std::to_string(n) +
+                   ", pop=" + std::to_string(tam) + ")";
+            return false;
+        }
+        if (largura_gene != static_cast<int32_t>(sizeof(Gene)))
+        {
+            erro = "checkpoint com genes de " + std::to_string(8 * largura_gene) + " bits";
+            return false;
+        }
+        // Outra seed sorteia outros fluxos a partir da época salva
+        if (seed != static_cast<int32_t>(config.seed))
+        {
+            erro = "checkpoint gravado com seed " + std::to_string(seed);
+            return false;
+        }
+        if (assinatura != assinaturaConfig())
+        {
+            erro = "checkpoint gravado com outros parâmetros do GA (operadores ou taxas)";
+            return false;
+        }
+
+        alocarEstruturas();
+        bool ok = in.vetor(populacao.genes.data(), populacao.genes.size()) &&
+                  in.vetor(populacao.fitness.data(), populacao.fitness.size()) &&
+                  in.vetor(melhor_todos.rota) && in.valor(melhor_todos.fitness);
+        for (auto *historico : {&melhor_por_epoca, &media_por_epoca, &pior_por_epoca,
+                                &desvio_por_epoca, &mediana_por_epoca})
+            ok = ok && in.vetor(*historico);
+        if (!ok || !in.fim())
+        {
+            erro = "checkpoint com conteúdo inválido";
+            return false;
+        }
+
+        // O melhor de todos precisa valer nesta instância (coordenadas iguais)
+        if (!tsp.rotaValida(melhor_todos.rota) ||
+            std::abs(tsp.compRota(melhor_todos.rota) - melhor_todos.fitness) > 1e-6 * (1.0 + melhor_todos.fitness))
+        {
+            erro = "checkpoint não corresponde à instância carregada";
+            return false;
+        }
+        generations_without_improvement = sem_melhora;
+        epoca = epoca_salva;
+        for (int i = 0; i < populacao.tam; ++i)
+            atualizarHash(populacao, i);
+        estatisticas = calcularEstatisticas(populacao.fitness.data(), populacao.tam, trabalho_estatisticas);
+        return true;
+    }
+
+    // Executa GA pelas épocas configuradas
+    void run()
+    {
+        initPop();
+
+        for (int epocas = 0; epocas < config.num_epocas; ++epocas)
+        {
+            passo();
+
+            if (pacienciaEsgotada())
             {
-                // Corta vetores para as épocas realmente executadas
-                melhor_por_epoca.resize(epocas + 1);
-                media_por_epoca.resize(epocas + 1);
-                pior_por_epoca.resize(epocas + 1);
                 break;
             }
         }
@@ -343,8 +1249,28 @@ public:
     const std::vector<double> &getMelhorPorEpoca() const { return melhor_por_epoca; }
     const std::vector<double> &getMediaPorEpoca() const { return media_por_epoca; }
     const std::vector<double> &getPiorPorEpoca() const { return pior_por_epoca; }
-    const std::vector<Individual> &getPopulacao() const { return populacao; }
+    const std::vector<double> &getDesvioPorEpoca() const { return desvio_por_epoca; }
+    const std::vector<double> &getMedianaPorEpoca() const { return mediana_por_epoca; }
+    const EstatisticasGeracao &getEstatisticas() const { return estatisticas; }
+    const Populacao<Gene> &getPopulacao() const { return populacao; }
+    const GAConfig &getConfig() const { return config; }
     int getMelhorEpocaAtual() const { return melhor_por_epoca.size(); }
+
+    long getAvaliacoesPoupadas() const
+    {
+        long total = 0;
+        for (const auto &ctx : contextos)
+            total += ctx.avaliacoes_poupadas;
+        return total;
+    }
+
+    long getDuplicatasTratadas() const
+    {
+        long total = 0;
+        for (const auto &ctx : contextos)
+            total += ctx.duplicatas;
+        return total;
+    }
 };
 
 #endif // GA_HPP
@@ -0,0 +1,370 @@
+#ifndef GIF_HPP
+#define GIF_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Quadro rasterizado com paleta de até 256 cores (um índice por pixel)
+class QuadroRaster
+{
+private:
+    int largura;
+    int altura;
+    std::vector<uint8_t> pixels;
+
+    // Fonte 3x5 para números (bit 2 = coluna esquerda), usada nos rótulos
+    static const uint8_t *glifo(char c)
+    {
+        static const uint8_t digitos[10][5] = {
+            {7, 5, 5, 5, 7}, {2, 6, 2, 2, 7}, {7, 1, 7, 4, 7}, {7, 1, 7, 1, 7}, {5, 5, 7, 1, 1},
+            {7, 4, 7, 1, 7}, {7, 4, 7, 5, 7}, {7, 1, 1, 1, 1}, {7, 5, 7, 5, 7}, {7, 5, 7, 1, 7}};
+        static const uint8_t ponto[5] = {0, 0, 0, 0, 2};
+        static const uint8_t barra[5] = {1, 1, 2, 4, 4};
+        if (c >= '0' && c <= '9')
+            return digitos[c - '0'];
+        if (c == '.')
+            return ponto;
+        if (c == '/')
+            return barra;
+        return nullptr;
+    }
+
+public:
+    QuadroRaster(int w, int h) : largura(w), altura(h), pixels(static_cast<size_t>(w) * h, 0) {}
+
+    int getLargura() const { return largura; }
+    int getAltura() const { return altura; }
+    const uint8_t *dados() const { return pixels.data(); }
+
+    void limpar(uint8_t cor) { std::fill(pixels.begin(), pixels.end(), cor); }
+
+    void pixel(int x, int y, uint8_t cor)
+    {
+        if (x >= 0 && x < largura && y >= 0 && y < altura)
+            pixels[static_cast<size_t>(y) * largura + x] = cor;
+    }
+
+    void retangulo(int x0, int y0, int x1, int y1, uint8_t cor)
+    {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, largura - 1);
+        y1 = std::min(y1, altura - 1);
+        for (int y = y0; y <= y1; ++y)
+            std::fill(pixels.begin() + static_cast<size_t>(y) * largura + x0,
+                      pixels.begin() + static_cast<size_t>(y) * largura + x1 + 1, cor);
+    }
+
+    // Bresenham com espessura de 2 pixels
+    void linha(int x0, int y0, int x1, int y1, uint8_t cor)
+    {
+        int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+        int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+        bool horizontal = dx >= -dy;
+        int erro = dx + dy;
+        while (true)
+        {
+            pixel(x0, y0, cor);
+            if (horizontal)
+                pixel(x0, y0 + 1, cor);
+            else
+                pixel(x0 + 1, y0, cor);
+            if (x0 == x1 && y0 == y1)
+                break;
+            int e2 = 2 * erro;
+            if (e2 >= dy)
+            {
+                erro += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx)
+            {
+                erro += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    // Texto com a fonte 3x5 ampliada por escala (só dígitos, '.' e '/')
+    void texto(int x, int y, const std::string &s, uint8_t cor, int escala = 3)
+    {
+        for (char c : s)
+        {
+            const uint8_t *g = glifo(c);
+            if (g)
+            {
+                for (int lin = 0; lin < 5; ++lin)
+                    for (int col = 0; col < 3; ++col)
+                        if (g[lin] & (4 >> col))
+                            retangulo(x + col * escala, y + lin * escala,
+                                      x + (col + 1) * escala - 1, y + (lin + 1) * escala - 1, cor);
+            }
+            x += 4 * escala;
+        }
+    }
+};
+
+// Gravação incremental de GIF89a animado
+// Cada quadro é comparado com o anterior: só o retângulo que mudou é
+// codificado, e dentro dele os pixels iguais viram o índice transparente,
+// o que alonga as sequências do LZW. O arquivo é escrito quadro a quadro.
+class CodificadorGIF
+{
+private:
+    FILE *arquivo = nullptr;
+    int largura = 0;
+    int altura = 0;
+    int bits_paleta = 2; // tamanho mínimo de código do LZW
+    int transparente = 0;
+    int atraso_cs = 10;
+    std::vector<uint8_t> anterior;
+    std::vector<uint8_t> recorte;
+    std::vector<int16_t> dicionario; // (prefixo, índice) -> código, -1 = vazio
+    int quadros = 0;
+
+    // Acumulador de bits em sub-blocos de até 255 bytes
+    uint32_t acumulador = 0;
+    int bits_acumulados = 0;
+    uint8_t bloco[255];
+    int tam_bloco = 0;
+
+    void escreverByte(uint8_t b) { std::fputc(b, arquivo); }
+
+    void escrever16(int v)
+    {
+        escreverByte(static_cast<uint8_t>(v & 0xFF));
+        escreverByte(static_cast<uint8_t>((v >> 8) & 0xFF));
+    }
+
+    void emitirByteBloco(uint8_t b)
+    {
+        bloco[tam_bloco++] = b;
+        if (tam_bloco == 255)
+        {
+            escreverByte(255);
+            std::fwrite(bloco, 1, 255, arquivo);
+            tam_bloco = 0;
+        }
+    }
+
+    void emitirCodigo(int codigo, int tamanho)
+    {
+        acumulador |= static_cast<uint32_t>(codigo) << bits_acumulados;
+        bits_acumulados += tamanho;
+        while (bits_acumulados >= 8)
+        {
+            emitirByteBloco(static_cast<uint8_t>(acumulador & 0xFF));
+            acumulador >>= 8;
+            bits_acumulados -= 8;
+        }
+    }
+
+    void finalizarBlocos()
+    {
+        if (bits_acumulados > 0)
+            emitirByteBloco(static_cast<uint8_t>(acumulador & 0xFF));
+        acumulador = 0;
+        bits_acumulados = 0;
+        if (tam_bloco > 0)
+        {
+            escreverByte(static_cast<uint8_t>(tam_bloco));
+            std::fwrite(bloco, 1, tam_bloco, arquivo);
+            tam_bloco = 0;
+        }
+        escreverByte(0);
+    }
+
+    // LZW do GIF com códigos de largura variável (até 12 bits)
+    void codificarLZW(const uint8_t *indices, size_t n)
+    {
+        const int num_cores = 1 << bits_paleta;
+        const int limpar = num_cores;
+        const int fim = limpar + 1;
+        dicionario.assign(static_cast<size_t>(4096) * num_cores, -1);
+
+        escreverByte(static_cast<uint8_t>(bits_paleta));
+        int tamanho = bits_paleta + 1;
+        int maior = fim; // último código atribuído
+        emitirCodigo(limpar, tamanho);
+
+        int atual = indices[0];
+        for (size_t i = 1; i < n; ++i)
+        {
+            int k = indices[i];
+            int16_t &entrada = dicionario[static_cast<size_t>(atual) * num_cores + k];
+            if (entrada >= 0)
+            {
+                atual = entrada;
+                continue;
+            }
+            emitirCodigo(atual, tamanho);
+            if (maior < 4095)
+            {
+                entrada = static_cast<int16_t>(++maior);
+                if (maior >= (1 << tamanho))
+                    ++tamanho;
+            }
+            else
+            {
+                // Dicionário cheio: recomeça
+                emitirCodigo(limpar, tamanho);
+                std::fill(dicionario.begin(), dicionario.end(), static_cast<int16_t>(-1));
+                tamanho = bits_paleta + 1;
+                maior = fim;
+            }
+            atual = k;
+        }
+        emitirCodigo(atual, tamanho);
+        // O decodificador acrescenta uma entrada ao ler o último código e pode
+        // aumentar a largura antes do código de fim
+        if (maior < 4095 && maior + 1 >= (1 << tamanho))
+            ++tamanho;
+        emitirCodigo(fim, tamanho);
+        finalizarBlocos();
+    }
+
+public:
+    CodificadorGIF() = default;
+    ~CodificadorGIF() { fechar(); }
+
+    CodificadorGIF(const CodificadorGIF &) = delete;
+    CodificadorGIF &operator=(const CodificadorGIF &) = delete;
+
+    // paleta em RGB (3 bytes por cor, até 255 cores); o índice seguinte ao
+    // último da paleta é reservado para transparência nos quadros delta
+    bool abrir(const std::string &filename, int w, int h, const std::vector<uint8_t> &paleta,
+               int atraso_centesimos = 10)
+    {
+        fechar();
+        int num_cores = static_cast<int>(paleta.size() / 3);
+        if (w <= 0 || h <= 0 || num_cores < 1 || num_cores > 255)
+            return false;
+        arquivo = std::fopen(filename.c_str(), "wb");
+        if (!arquivo)
+            return false;
+
+        largura = w;
+        altura = h;
+        atraso_cs = atraso_centesimos;
+        transparente = num_cores;
+        bits_paleta = 2;
+        while ((1 << bits_paleta) < num_cores + 1)
+            ++bits_paleta;
+        anterior.clear();
+        quadros = 0;
+
+        std::fwrite("GIF89a", 1, 6, arquivo);
+        escrever16(w);
+        escrever16(h);
+        escreverByte(static_cast<uint8_t>(0x80 | ((bits_paleta - 1) << 4) | (bits_paleta - 1)));
+        escreverByte(0); // fundo
+        escreverByte(0); // proporção de pixel
+        for (int c = 0; c < (1 << bits_paleta); ++c)
+            for (int j = 0; j < 3; ++j)
+                escreverByte(c < num_cores ? paleta[3 * c + j] : 0);
+
+        // Extensão NETSCAPE2.0: repete a animação indefinidamente
+        escreverByte(0x21);
+        escreverByte(0xFF);
+        escreverByte(11);
+        std::fwrite("NETSCAPE2.0", 1, 11, arquivo);
+        escreverByte(3);
+        escreverByte(1);
+        escrever16(0);
+        escreverByte(0);
+        return true;
+    }
+
+    bool aberto() const { return arquivo != nullptr; }
+    int getQuadros() const { return quadros; }
+
+    // Acrescenta um quadro (largura*altura índices da paleta)
+    void adicionarQuadro(const uint8_t *indices)
+    {
+        if (!arquivo)
+            return;
+
+        // Retângulo que mudou desde o quadro anterior (o primeiro é inteiro)
+        int x0 = 0, y0 = 0, x1 = largura - 1, y1 = altura - 1;
+        bool delta = !anterior.empty();
+        if (delta)
+        {
+            x0 = largura;
+            y0 = altura;
+            x1 = -1;
+            y1 = -1;
+            for (int y = 0; y < altura; ++y)
+            {
+                const uint8_t *a = &anterior[static_cast<size_t>(y) * largura];
+                const uint8_t *b = indices + static_cast<size_t>(y) * largura;
+                int xa = 0;
+                while (xa < largura && a[xa] == b[xa])
+                    ++xa;
+                if (xa == largura)
+                    continue;
+                int xb = largura - 1;
+                while (a[xb] == b[xb])
+                    --xb;
+                x0 = std::min(x0, xa);
+                x1 = std::max(x1, xb);
+                y0 = std::min(y0, y);
+                y1 = y;
+            }
+            if (x1 < 0)
+            {
+                // Nada mudou: um pixel transparente mantém o tempo do quadro
+                x0 = x1 = y0 = y1 = 0;
+            }
+        }
+
+        int w = x1 - x0 + 1;
+        int h = y1 - y0 + 1;
+        recorte.resize(static_cast<size_t>(w) * h);
+        for (int y = 0; y < h; ++y)
+        {
+            size_t origem = static_cast<size_t>(y0 + y) * largura + x0;
+            for (int x = 0; x < w; ++x)
+            {
+                uint8_t v = indices[origem + x];
+                recorte[static_cast<size_t>(y) * w + x] =
+                    delta && anterior[origem + x] == v ? static_cast<uint8_t>(transparente) : v;
+            }
+        }
+
+        // Controle gráfico: atraso, não descartar (o próximo quadro se
+        // sobrepõe a este) e índice transparente nos quadros delta
+        escreverByte(0x21);
+        escreverByte(0xF9);
+        escreverByte(4);
+        escreverByte(static_cast<uint8_t>(0x04 | (delta ? 1 : 0)));
+        escrever16(atraso_cs);
+        escreverByte(static_cast<uint8_t>(transparente));
+        escreverByte(0);
+
+        escreverByte(0x2C);
+        escrever16(x0);
+        escrever16(y0);
+        escrever16(w);
+        escrever16(h);
+        escreverByte(0);
+        codificarLZW(recorte.data(), recorte.size());
+
+        anterior.assign(indices, indices + static_cast<size_t>(largura) * altura);
+        ++quadros;
+    }
+
+    void fechar()
+    {
+        if (!arquivo)
+            return;
+        escreverByte(0x3B);
+        std::fclose(arquivo);
+        arquivo = nullptr;
+    }
+};
+
+#endif // GIF_HPP
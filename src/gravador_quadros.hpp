@@ -0,0 +1,238 @@
+#ifndef GRAVADOR_QUADROS_HPP
+#define GRAVADOR_QUADROS_HPP
+
+#include "tsp.hpp"
+#include "ga.hpp"
+#include "plot_utils.hpp"
+#include "gif.hpp"
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Gravação de quadros numa thread própria, fora do laço de gerações
+// enviar() só copia a melhor rota para a fila e retorna; a thread gravadora
+// monta o quadro e escreve em disco. A fila é limitada: cheia, o quadro novo
+// substitui o último pendente (quadros intermediários são combinados) em vez
+// de bloquear a evolução. O primeiro e o último quadro nunca se perdem.
+// Os quadros podem ir para SVGs em framesdir, para um GIF animado rasterizado
+// aqui mesmo (sem ferramentas externas) ou para ambos.
+enum class FormatoQuadros
+{
+    NENHUM,
+    SVG,
+    GIF,
+    AMBOS
+};
+
+class GravadorQuadros
+{
+private:
+    struct QuadroPendente
+    {
+        int epoca;
+        Individual melhor;
+    };
+
+    const InstanciaTSP &tsp;
+    GAConfig config;
+    std::string framesdir;
+    size_t capacidade;
+    bool svg;
+    bool gif;
+
+    // Saída GIF: quadro rasterizado e transformação dos pontos para pixels
+    static constexpr int GIF_LARGURA = 800;
+    static constexpr int GIF_ALTURA = 600;
+    static constexpr int GIF_MARGEM = 20;
+    static constexpr int GIF_TOPO = 50; // faixa dos rótulos
+    enum CorGIF : uint8_t
+    {
+        COR_FUNDO,
+        COR_ROTA,
+        COR_PONTO,
+        COR_TEXTO
+    };
+    QuadroRaster raster{GIF_LARGURA, GIF_ALTURA};
+    CodificadorGIF codificador;
+    std::vector<int> px, py;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<QuadroPendente> fila;
+    std::vector<Rota> livres; // rotas já gravadas, reaproveitadas nas cópias
+    bool parar = false;
+    int gravados = 0;
+    int combinados = 0;
+    std::thread thread;
+
+    void laco()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true)
+        {
+            cv.wait(lock, [&]
+                    { return parar || !fila.empty(); });
+            if (fila.empty())
+                return; // parar e nada pendente
+
+            QuadroPendente quadro = std::move(fila.front());
+            fila.pop_front();
+            lock.unlock();
+
+            if (svg)
+                plotRotaEpoca(tsp, quadro.melhor, quadro.epoca, config, getFrameFilename(framesdir, quadro.epoca));
+            if (gif)
+            {
+                rasterizar(quadro);
+                codificador.adicionarQuadro(raster.dados());
+            }
+
+            lock.lock();
+            ++gravados;
+            livres.push_back(std::move(quadro.melhor.rota));
+        }
+    }
+
+    // Converte os pontos para pixels uma vez (escala uniforme, y para cima)
+    void prepararTransformacao()
+    {
+        const auto &ptos = tsp.getPoints();
+        double xmin = std::numeric_limits<double>::max(), xmax = -xmin;
+        double ymin = xmin, ymax = -xmin;
+        for (const auto &p : ptos)
+        {
+            xmin = std::min(xmin, p.x);
+            xmax = std::max(xmax, p.x);
+            ymin = std::min(ymin, p.y);
+            ymax = std::max(ymax, p.y);
+        }
+        double largura_util = GIF_LARGURA - 2 * GIF_MARGEM;
+        double altura_util = GIF_ALTURA - GIF_TOPO - GIF_MARGEM;
+        double escala = std::min(largura_util / std::max(xmax - xmin, 1e-12),
+                                 altura_util / std::max(ymax - ymin, 1e-12));
+        double ox = GIF_MARGEM + 0.5 * (largura_util - escala * (xmax - xmin));
+        double oy = GIF_TOPO + 0.5 * (altura_util - escala * (ymax - ymin));
+
+        px.resize(ptos.size());
+        py.resize(ptos.size());
+        for (size_t i = 0; i < ptos.size(); ++i)
+        {
+            px[i] = static_cast<int>(ox + escala * (ptos[i].x - xmin) + 0.5);
+            py[i] = static_cast<int>(oy + escala * (ymax - ptos[i].y) + 0.5);
+        }
+    }
+
+    // Desenha rota, pontos e rótulos (época e comprimento) no quadro raster
+    void rasterizar(const QuadroPendente &quadro)
+    {
+        raster.limpar(COR_FUNDO);
+        const Rota &rota = quadro.melhor.rota;
+        for (size_t i = 0; i < rota.size(); ++i)
+        {
+            int a = rota[i];
+            int b = rota[(i + 1) % rota.size()];
+            raster.linha(px[a], py[a], px[b], py[b], COR_ROTA);
+        }
+        for (size_t i = 0; i < px.size(); ++i)
+            raster.retangulo(px[i] - 2, py[i] - 2, px[i] + 2, py[i] + 2, COR_PONTO);
+
+        std::ostringstream comprimento;
+        comprimento << std::fixed << std::setprecision(2) << quadro.melhor.fitness;
+        raster.texto(GIF_MARGEM, 8, std::to_string(quadro.epoca), COR_TEXTO);
+        raster.texto(GIF_MARGEM + 120, 8, comprimento.str(), COR_TEXTO);
+    }
+
+public:
+    // arquivo_gif é usado quando o formato inclui GIF; atraso em centésimos de segundo
+    GravadorQuadros(const InstanciaTSP &tsp_instance, const GAConfig &cfg, const std::string &dir,
+                    FormatoQuadros formato = FormatoQuadros::SVG, const std::string &arquivo_gif = "",
+                    int atraso_gif = 10, size_t capacidade_fila = 8)
+        : tsp(tsp_instance), config(cfg), framesdir(dir), capacidade(std::max<size_t>(2, capacidade_fila)),
+          svg(formato == FormatoQuadros::SVG || formato == FormatoQuadros::AMBOS),
+          gif(formato == FormatoQuadros::GIF || formato == FormatoQuadros::AMBOS)
+    {
+        if (gif)
+        {
+            // Paleta: fundo, rota, pontos e texto (cores dos SVGs)
+            const std::vector<uint8_t> paleta = {0xFF, 0xFF, 0xFF, 0x00, 0x66, 0xCC,
+                                                 0xFF, 0x66, 0x00, 0x33, 0x33, 0x33};
+            if (codificador.abrir(arquivo_gif, GIF_LARGURA, GIF_ALTURA, paleta, atraso_gif))
+            {
+                prepararTransformacao();
+            }
+            else
+            {
+                std::cerr << "Aviso: não foi possível criar " << arquivo_gif << "\n";
+                gif = false;
+            }
+        }
+        if (svg || gif)
+        {
+            thread = std::thread([this]
+                                 { laco(); });
+        }
+    }
+
+    ~GravadorQuadros() { finalizar(); }
+
+    GravadorQuadros(const GravadorQuadros &) = delete;
+    GravadorQuadros &operator=(const GravadorQuadros &) = delete;
+
+    // Enfileira um instantâneo da melhor rota da época (não bloqueia em E/S)
+    void enviar(const Individual &melhor, int epoca)
+    {
+        if (!svg && !gif)
+            return;
+        std::lock_guard<std::mutex> lock(mtx);
+        if (parar)
+            return;
+
+        QuadroPendente *destino;
+        if (fila.size() < capacidade)
+        {
+            fila.push_back(QuadroPendente{epoca, Individual()});
+            destino = &fila.back();
+            if (!livres.empty())
+            {
+                destino->melhor.rota = std::move(livres.back());
+                livres.pop_back();
+            }
+        }
+        else
+        {
+            // Fila cheia: o pendente mais novo dá lugar a este (o da frente,
+            // mais antigo, é mantido para o vídeo não pular o início)
+            destino = &fila.back();
+            destino->epoca = epoca;
+            ++combinados;
+        }
+        destino->melhor.rota.assign(melhor.rota.begin(), melhor.rota.end());
+        destino->melhor.fitness = melhor.fitness;
+        cv.notify_one();
+    }
+
+    // Grava o que ainda estiver na fila e encerra a thread
+    void finalizar()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            parar = true;
+        }
+        cv.notify_one();
+        if (thread.joinable())
+            thread.join();
+        codificador.fechar();
+    }
+
+    // Contadores válidos após finalizar()
+    int getGravados() const { return gravados; }
+    int getCombinados() const { return combinados; }
+    bool gravaSVG() const { return svg; }
+    bool gravaGIF() const { return gif; }
+};
+
+#endif // GRAVADOR_QUADROS_HPP
@@ -0,0 +1,104 @@
+#ifndef HASH_ROTA_HPP
+#define HASH_ROTA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Hash de rotas invariante a rotação e sentido (estilo Zobrist sobre arestas)
+// Cada ponto recebe uma chave aleatória ímpar z[i]; a aresta {a, b} vale
+// z[a]*z[b], que não depende do sentido, e a rota é a soma das suas arestas
+// módulo 2^64, que não depende do ponto de partida. Duas rotas com o mesmo
+// conjunto de arestas têm o mesmo hash.
+class HashRotas
+{
+private:
+    std::vector<uint64_t> chaves;
+
+public:
+    void inicializar(int n, uint64_t semente = 0x9E3779B97F4A7C15ull)
+    {
+        // splitmix64: chaves bem espalhadas a partir de uma semente fixa
+        chaves.resize(n);
+        uint64_t x = semente;
+        for (int i = 0; i < n; ++i)
+        {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            chaves[i] = (z ^ (z >> 31)) | 1;
+        }
+    }
+
+    bool inicializado() const { return !chaves.empty(); }
+
+    uint64_t aresta(int a, int b) const { return chaves[a] * chaves[b]; }
+
+    template <typename G>
+    uint64_t hash(const G *rota, int n) const
+    {
+        uint64_t h = aresta(rota[n - 1], rota[0]);
+        for (int i = 0; i + 1 < n; ++i)
+            h += aresta(rota[i], rota[i + 1]);
+        return h;
+    }
+};
+
+// Fitness por hash de rota (endereçamento aberto com sondagem linear)
+// O GA a reconstrói com a população atual no início de cada geração; na fase
+// paralela ela só é lida, então dispensa travas.
+class CacheFitness
+{
+private:
+    static constexpr uint64_t VAZIO = 0;
+    std::vector<uint64_t> chaves;
+    std::vector<double> valores;
+    size_t mascara = 0;
+
+    // O hash 0 marca posição vazia e é guardado como 1
+    static uint64_t chave(uint64_t h) { return h == VAZIO ? 1 : h; }
+
+    size_t posicao(uint64_t c) const
+    {
+        size_t i = static_cast<size_t>(c ^ (c >> 29)) & mascara;
+        while (chaves[i] != VAZIO && chaves[i] != c)
+            i = (i + 1) & mascara;
+        return i;
+    }
+
+public:
+    void construir(const uint64_t *hashes, const double *fitness, int tam)
+    {
+        size_t capacidade = 16;
+        while (capacidade < 2 * static_cast<size_t>(tam))
+            capacidade *= 2;
+        chaves.assign(capacidade, VAZIO);
+        valores.resize(capacidade);
+        mascara = capacidade - 1;
+        for (int i = 0; i < tam; ++i)
+        {
+            uint64_t c = chave(hashes[i]);
+            size_t p = posicao(c);
+            chaves[p] = c;
+            valores[p] = fitness[i];
+        }
+    }
+
+    bool buscar(uint64_t h, double &fitness) const
+    {
+        if (chaves.empty())
+            return false;
+        size_t p = posicao(chave(h));
+        if (chaves[p] == VAZIO)
+            return false;
+        fitness = valores[p];
+        return true;
+    }
+
+    bool contem(uint64_t h) const
+    {
+        return !chaves.empty() && chaves[posicao(chave(h))] != VAZIO;
+    }
+};
+
+#endif // HASH_ROTA_HPP
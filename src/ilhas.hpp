@@ -0,0 +1,201 @@
+#ifndef ILHAS_HPP
+#define ILHAS_HPP
+
+#include "tsp.hpp"
+#include "ga.hpp"
+#include "pool_threads.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Topologia de migração entre ilhas
+// ANEL:      ilha i envia para i+1
+// COMPLETA:  ilha i envia para todas as outras
+// ALEATORIA: ilha i envia para uma ilha sorteada a cada migração
+enum class TopologiaMigracao
+{
+    ANEL,
+    COMPLETA,
+    ALEATORIA
+};
+
+// Parâmetros do modelo de ilhas (os da evolução ficam no GAConfig de cada ilha)
+struct ConfigIlhas
+{
+    int num_epocas = 500;
+    int intervalo_migracao = 25; // épocas entre migrações
+    int num_migrantes = 2;       // melhores enviados por ilha a cada migração
+    int paciencia = 200;         // épocas sem melhora global para parar
+    int num_threads = 0;         // 0 = uma thread por ilha
+    TopologiaMigracao topologia = TopologiaMigracao::ANEL;
+    int seed = 42; // sorteio de destinos na topologia aleatória
+};
+
+// Modelo de ilhas: K subpopulações evoluem em paralelo e trocam seus
+// melhores indivíduos a cada intervalo_migracao épocas.
+// O num_epocas/paciencia de cada GAConfig é ignorado; quem controla as
+// épocas e a parada é o ConfigIlhas. Os migrantes viajam como Individual,
+// então o tipo de gene das ilhas não aparece na troca.
+template <typename Gene>
+class ModeloIlhas
+{
+private:
+    const InstanciaTSP &tsp;
+    ConfigIlhas config;
+    std::vector<std::unique_ptr<GeneticAlgorithm<Gene>>> ilhas;
+    std::unique_ptr<PoolThreads> pool;
+    GeradorPhilox rng; // destinos da topologia aleatória, fluxo (migração, época, ilha)
+
+    std::vector<double> melhor_global_por_epoca;
+    Individual melhor_todos;
+    int epocas_executadas = 0;
+
+    // Envia os melhores de cada ilha segundo a topologia (troca síncrona:
+    // os emigrantes de todas as ilhas são copiados antes de qualquer chegada)
+    void migrar(int epoca)
+    {
+        int k = static_cast<int>(ilhas.size());
+        if (k < 2 || config.num_migrantes <= 0)
+            return;
+
+        std::vector<std::vector<Individual>> emigrantes(k);
+        for (int i = 0; i < k; ++i)
+        {
+            emigrantes[i] = ilhas[i]->melhores(config.num_migrantes);
+        }
+
+        std::vector<std::vector<Individual>> chegadas(k);
+        for (int i = 0; i < k; ++i)
+        {
+            switch (config.topologia)
+            {
+            case TopologiaMigracao::ANEL:
+            {
+                auto &destino = chegadas[(i + 1) % k];
+                destino.insert(destino.end(), emigrantes[i].begin(), emigrantes[i].end());
+                break;
+            }
+            case TopologiaMigracao::COMPLETA:
+                for (int j = 0; j < k; ++j)
+                {
+                    if (j != i)
+                        chegadas[j].insert(chegadas[j].end(), emigrantes[i].begin(), emigrantes[i].end());
+                }
+                break;
+            case TopologiaMigracao::ALEATORIA:
+            {
+                rng.posicionar(FLUXO_MIGRACAO, static_cast<uint32_t>(epoca), static_cast<uint32_t>(i));
+                int j = static_cast<int>(rng.abaixoDe(static_cast<uint32_t>(k - 1)));
+                if (j >= i)
+                    ++j;
+                chegadas[j].insert(chegadas[j].end(), emigrantes[i].begin(), emigrantes[i].end());
+                break;
+            }
+            }
+        }
+
+        for (int i = 0; i < k; ++i)
+        {
+            ilhas[i]->receberMigrantes(chegadas[i]);
+        }
+    }
+
+    // Atualiza o melhor global a partir das ilhas; devolve true se melhorou
+    bool atualizarMelhorGlobal()
+    {
+        bool melhorou = false;
+        for (const auto &ilha : ilhas)
+        {
+            if (ilha->getMelhorTodos().fitness < melhor_todos.fitness)
+            {
+                melhor_todos = ilha->getMelhorTodos();
+                melhorou = true;
+            }
+        }
+        return melhorou;
+    }
+
+public:
+    ModeloIlhas(const InstanciaTSP &tsp_instance, const std::vector<GAConfig> &configs_ilhas,
+                const ConfigIlhas &cfg)
+        : tsp(tsp_instance), config(cfg), rng(static_cast<uint32_t>(cfg.seed))
+    {
+        for (const auto &c : configs_ilhas)
+        {
+            ilhas.push_back(std::make_unique<GeneticAlgorithm<Gene>>(tsp, c));
+        }
+        int threads = config.num_threads > 0 ? config.num_threads : static_cast<int>(ilhas.size());
+        threads = std::min(threads, static_cast<int>(ilhas.size()));
+        if (threads > 1)
+        {
+            pool = std::make_unique<PoolThreads>(threads);
+        }
+    }
+
+    // Executa o modelo; ao_fim_bloco(epoca) é chamado após cada bloco de
+    // épocas (e migração), útil para quadros e progresso
+    void run(const std::function<void(int)> &ao_fim_bloco = nullptr)
+    {
+        int k = static_cast<int>(ilhas.size());
+        auto inicializar = [&](int i)
+        { ilhas[i]->initPop(); };
+        if (pool)
+            pool->executar(k, inicializar);
+        else
+            for (int i = 0; i < k; ++i)
+                inicializar(i);
+        atualizarMelhorGlobal();
+
+        int intervalo = std::max(1, config.intervalo_migracao);
+        int sem_melhora = 0;
+        int epoca = 0;
+        while (epoca < config.num_epocas)
+        {
+            int bloco = std::min(intervalo, config.num_epocas - epoca);
+            auto evoluirIlha = [&](int i)
+            {
+                for (int e = 0; e < bloco; ++e)
+                    ilhas[i]->passo();
+            };
+            if (pool)
+                pool->executar(k, evoluirIlha);
+            else
+                for (int i = 0; i < k; ++i)
+                    evoluirIlha(i);
+
+            // Histórico global: mínimo entre ilhas, acumulado ao longo das épocas
+            for (int e = 0; e < bloco; ++e)
+            {
+                double melhor = melhor_global_por_epoca.empty() ? melhor_todos.fitness
+                                                                : melhor_global_por_epoca.back();
+                for (const auto &ilha : ilhas)
+                {
+                    melhor = std::min(melhor, ilha->getMelhorPorEpoca()[epoca + e]);
+                }
+                melhor_global_por_epoca.push_back(melhor);
+            }
+            epoca += bloco;
+            epocas_executadas = epoca;
+
+            sem_melhora = atualizarMelhorGlobal() ? 0 : sem_melhora + bloco;
+            if (epoca < config.num_epocas)
+                migrar(epoca);
+            atualizarMelhorGlobal();
+
+            if (ao_fim_bloco)
+                ao_fim_bloco(epoca);
+
+            if (sem_melhora >= config.paciencia)
+                break;
+        }
+    }
+
+    // Métodos de acesso
+    const Individual &getMelhorTodos() const { return melhor_todos; }
+    const std::vector<double> &getMelhorGlobalPorEpoca() const { return melhor_global_por_epoca; }
+    int getNumIlhas() const { return static_cast<int>(ilhas.size()); }
+    const GeneticAlgorithm<Gene> &getIlha(int i) const { return *ilhas[i]; }
+    int getEpocasExecutadas() const { return epocas_executadas; }
+};
+
+#endif // ILHAS_HPP
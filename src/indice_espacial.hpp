@@ -0,0 +1,213 @@
+#ifndef INDICE_ESPACIAL_HPP
+#define INDICE_ESPACIAL_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Árvore k-d (2D) sobre os pontos de uma instância
+// Construída uma vez em O(n log n); consultas de k vizinhos mais próximos e
+// de raio. Empates de distância são desfeitos pelo menor id. Pontos podem ser
+// removidos em O(log n): cada nó conta os pontos ativos abaixo dele, e
+// subárvores vazias são puladas nas consultas.
+class KDTree
+{
+private:
+    struct No
+    {
+        double corte = 0.0;
+        int dim = 0;
+        int esq = -1; // -1 = folha
+        int dir = -1;
+        int inicio = 0; // intervalo em idx (folhas)
+        int fim = 0;
+    };
+
+    static constexpr int TAM_FOLHA = 8;
+
+    std::vector<double> xs, ys;
+    std::vector<int> idx;
+    std::vector<No> nos;
+    std::vector<int> pai; // por nó (-1 = raiz)
+    std::vector<int> ativos; // por nó: pontos não removidos na subárvore
+    std::vector<int> folha; // por id
+    std::vector<char> removido;
+
+    double coord(int id, int dim) const { return dim == 0 ? xs[id] : ys[id]; }
+
+    int construirNo(int inicio, int fim)
+    {
+        int atual = static_cast<int>(nos.size());
+        nos.emplace_back();
+        pai.push_back(-1);
+        ativos.push_back(fim - inicio);
+        nos[atual].inicio = inicio;
+        nos[atual].fim = fim;
+        if (fim - inicio <= TAM_FOLHA)
+        {
+            for (int i = inicio; i < fim; ++i)
+                folha[idx[i]] = atual;
+            return atual;
+        }
+
+        // Corta na dimensão de maior extensão, pela mediana
+        double min_x = xs[idx[inicio]], max_x = min_x;
+        double min_y = ys[idx[inicio]], max_y = min_y;
+        for (int i = inicio + 1; i < fim; ++i)
+        {
+            min_x = std::min(min_x, xs[idx[i]]);
+            max_x = std::max(max_x, xs[idx[i]]);
+            min_y = std::min(min_y, ys[idx[i]]);
+            max_y = std::max(max_y, ys[idx[i]]);
+        }
+        int dim = (max_x - min_x >= max_y - min_y) ? 0 : 1;
+        int meio = inicio + (fim - inicio) / 2;
+        std::nth_element(idx.begin() + inicio, idx.begin() + meio, idx.begin() + fim,
+                         [&](int a, int b)
+                         { return coord(a, dim) < coord(b, dim); });
+
+        double corte = coord(idx[meio], dim);
+        int esq = construirNo(inicio, meio);
+        int dir = construirNo(meio, fim);
+        nos[atual].dim = dim;
+        nos[atual].corte = corte;
+        nos[atual].esq = esq;
+        nos[atual].dir = dir;
+        pai[esq] = atual;
+        pai[dir] = atual;
+        return atual;
+    }
+
+    // Par (distância², id) ordenado lexicograficamente: o topo do heap é o pior
+    using Candidato = std::pair<double, int>;
+
+    void buscarK(int no, double qx, double qy, int k, int excluir, std::vector<Candidato> &heap) const
+    {
+        if (ativos[no] == 0)
+            return;
+        const No &nd = nos[no];
+        if (nd.esq < 0)
+        {
+            for (int i = nd.inicio; i < nd.fim; ++i)
+            {
+                int id = idx[i];
+                if (id == excluir || removido[id])
+                    continue;
+                double dx = xs[id] - qx;
+                double dy = ys[id] - qy;
+                Candidato c(dx * dx + dy * dy, id);
+                if (static_cast<int>(heap.size()) < k)
+                {
+                    heap.push_back(c);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (c < heap.front())
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = c;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+            return;
+        }
+
+        double diff = (nd.dim == 0 ? qx : qy) - nd.corte;
+        int primeiro = diff < 0 ? nd.esq : nd.dir;
+        int segundo = diff < 0 ? nd.dir : nd.esq;
+        buscarK(primeiro, qx, qy, k, excluir, heap);
+        // <= para não perder empates do outro lado do corte
+        if (static_cast<int>(heap.size()) < k || diff * diff <= heap.front().first)
+            buscarK(segundo, qx, qy, k, excluir, heap);
+    }
+
+    void buscarRaio(int no, double qx, double qy, double r2, std::vector<int> &saida) const
+    {
+        if (ativos[no] == 0)
+            return;
+        const No &nd = nos[no];
+        if (nd.esq < 0)
+        {
+            for (int i = nd.inicio; i < nd.fim; ++i)
+            {
+                int id = idx[i];
+                if (removido[id])
+                    continue;
+                double dx = xs[id] - qx;
+                double dy = ys[id] - qy;
+                if (dx * dx + dy * dy <= r2)
+                    saida.push_back(id);
+            }
+            return;
+        }
+
+        double diff = (nd.dim == 0 ? qx : qy) - nd.corte;
+        if (diff <= 0 || diff * diff <= r2)
+            buscarRaio(nd.esq, qx, qy, r2, saida);
+        if (diff >= 0 || diff * diff <= r2)
+            buscarRaio(nd.dir, qx, qy, r2, saida);
+    }
+
+public:
+    // Constrói a árvore; PointT precisa expor x e y
+    template <typename PointT>
+    void construir(const std::vector<PointT> &pontos)
+    {
+        int n = static_cast<int>(pontos.size());
+        xs.resize(n);
+        ys.resize(n);
+        idx.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            xs[i] = pontos[i].x;
+            ys[i] = pontos[i].y;
+            idx[i] = i;
+        }
+        nos.clear();
+        nos.reserve(n > 0 ? 2 * (n / TAM_FOLHA + 1) : 0);
+        pai.clear();
+        ativos.clear();
+        folha.assign(n, -1);
+        removido.assign(n, 0);
+        if (n > 0)
+            construirNo(0, n);
+    }
+
+    bool vazia() const { return nos.empty(); }
+
+    // Tira o id das consultas seguintes
+    void remover(int id)
+    {
+        if (removido[id])
+            return;
+        removido[id] = 1;
+        for (int no = folha[id]; no >= 0; no = pai[no])
+            --ativos[no];
+    }
+
+    // k vizinhos mais próximos de (qx, qy), em ordem crescente de distância,
+    // ignorando o id excluir (use -1 para não ignorar nenhum)
+    void kVizinhos(double qx, double qy, int k, int excluir, std::vector<int> &saida) const
+    {
+        saida.clear();
+        if (nos.empty() || k <= 0)
+            return;
+
+        std::vector<Candidato> heap;
+        heap.reserve(k);
+        buscarK(0, qx, qy, k, excluir, heap);
+        std::sort_heap(heap.begin(), heap.end());
+        for (const auto &c : heap)
+            saida.push_back(c.second);
+    }
+
+    // Todos os ids a distância <= raio de (qx, qy), sem ordem definida
+    void noRaio(double qx, double qy, double raio, std::vector<int> &saida) const
+    {
+        saida.clear();
+        if (nos.empty())
+            return;
+        buscarRaio(0, qx, qy, raio * raio, saida);
+    }
+};
+
+#endif // INDICE_ESPACIAL_HPP
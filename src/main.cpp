@@ -1,6 +1,11 @@
 #include "tsp.hpp"
 #include "ga.hpp"
+#include "ilhas.hpp"
 #include "plot_utils.hpp"
+#include "tsplib.hpp"
+#include "gravador_quadros.hpp"
+#include "varredura.hpp"
+#include "perfil.hpp"
 #include <iostream>
 #include <string>
 #include <cstring>
@@ -12,38 +17,118 @@
 struct Config
 {
     std::string cenario = "uniforme";
+    std::string tsplib;     // instância TSPLIB (substitui cenario/pontos)
+    std::string otimo;      // rota ótima .opt.tour para calcular o gap
     int pontos = 50;
     int epocas = 500;
     int pop = 200;
     double tx_mutacao = 0.05;
+    std::string mutacao = "troca";
+    double tx_cruzamento = 1.0;
     std::string selection = "torneio";
     int torneio = 3;
+    double pressao_ranking = 1.5;
     std::string crossover = "ox";
     int alpha = 2;
     int paciencia = 100;
     int seed = 42;
     std::string outdir = "./outputs";
     std::string framesdir = "./frames";
+    std::string quadros = "svg"; // svg, gif, ambos ou nenhum
+    std::string checkpoint;         // arquivo de checkpoint (vazio = desativado)
+    double checkpoint_intervalo = 60.0; // segundos entre checkpoints
+    std::string resume;             // checkpoint de onde retomar
+    bool cache_fitness = false;
+    std::string duplicatas = "permitir";
+    std::string varredura;          // grade "chave=v1,v2;chave=..." (vazio = execução única)
+    int sementes = 1;               // sementes por configuração da varredura
+    std::string distancias = "auto";
+    int mem_distancias = 256; // MiB
+    std::string simd = "auto";
+    int threads = 1;
+    std::string semeadura = "aleatoria";
+    double fracao_semeada = 0.5;
+    std::string busca_local = "nenhuma";
+    double tx_busca_local = 0.1;
+    int vizinhos = 8;
+    int ilhas = 1;
+    int migracao = 25;
+    int migrantes = 2;
+    std::string topologia = "anel";
+    std::string grade_ilhas; // grade das configurações das ilhas (vazio = todas iguais)
     bool check_mode = false;
 
     void print() const
     {
         std::cout << "\n=== Configuração do Algoritmo Genético TSP ===\n";
-        std::cout << "Cenário:                " << cenario << "\n";
-        std::cout << "Número de pontos:      " << pontos << "\n";
+        if (tsplib.empty())
+        {
+            std::cout << "Cenário:                " << cenario << "\n";
+            std::cout << "Número de pontos:      " << pontos << "\n";
+        }
+        else
+        {
+            std::cout << "Instância TSPLIB:       " << tsplib << "\n";
+        }
         std::cout << "Épocas:                 " << epocas << "\n";
         std::cout << "Tamanho da população:   " << pop << "\n";
         std::cout << "Taxa de mutação:        " << tx_mutacao << "\n";
+        std::cout << "Mutação:                " << mutacao << "\n";
+        std::cout << "Crossover:              " << crossover << "\n";
+        std::cout << "Taxa de cruzamento:     " << tx_cruzamento << "\n";
         std::cout << "Seleção:                " << selection << "\n";
         if (selection == "torneio")
         {
             std::cout << "Tamanho do torneio:     " << torneio << "\n";
         }
+        else if (selection == "ranking")
+        {
+            std::cout << "Pressão do ranking:     " << pressao_ranking << "\n";
+        }
         std::cout << "Contagem de alpha:      " << alpha << "\n";
         std::cout << "Paciência:              " << paciencia << "\n";
         std::cout << "Semente aleatória:      " << seed << "\n";
+        std::cout << "Threads:                " << threads << "\n";
+        if (semeadura != "aleatoria")
+        {
+            std::cout << "Semeadura:              " << semeadura << " (fração " << fracao_semeada << ")\n";
+        }
+        if (busca_local != "nenhuma")
+        {
+            std::cout << "Busca local:            " << busca_local << " (" << vizinhos << " vizinhos";
+            if (busca_local == "amostra")
+                std::cout << ", taxa " << tx_busca_local;
+            std::cout << ")\n";
+        }
+        if (ilhas > 1)
+        {
+            std::cout << "Ilhas:                  " << ilhas << " (" << topologia << ", "
+                      << migrantes << " migrantes a cada " << migracao << " épocas)\n";
+            if (!grade_ilhas.empty())
+                std::cout << "Grade das ilhas:        " << grade_ilhas << "\n";
+        }
+        if (cache_fitness || duplicatas != "permitir")
+        {
+            std::cout << "Duplicatas:             " << duplicatas << (cache_fitness ? " (cache de fitness)" : "") << "\n";
+        }
+        std::cout << "Distâncias:             " << distancias << " (orçamento " << mem_distancias << " MiB"
+                  << (simd != "auto" ? ", kernel " + simd : std::string()) << ")\n";
         std::cout << "Diretório de saída:     " << outdir << "\n";
-        std::cout << "Diretório de quadros:   " << framesdir << "\n";
+        if (!varredura.empty())
+        {
+            std::cout << "Varredura:              " << varredura << " (" << sementes << " semente(s) cada)\n";
+        }
+        if (!checkpoint.empty())
+        {
+            std::cout << "Checkpoint:             " << checkpoint << " (a cada " << checkpoint_intervalo << " s)\n";
+        }
+        if (!resume.empty())
+        {
+            std::cout << "Retomando de:           " << resume << "\n";
+        }
+        std::cout << "Quadros:                " << quadros << "\n";
+        if (quadros == "svg" || quadros == "ambos")
+            std::cout << "Diretório de quadros:   " << framesdir << "\n";
         std::cout << "==============================================\n\n";
     }
 };
@@ -54,22 +139,54 @@ void printHelp(const char *program)
     std::cout << "Opções:\n";
     std::cout << "  --cenario {uniforme|circulo}  Tipo de cenário (padrão: uniforme)\n";
     std::cout << "  --pontos <int>                    Número de pontos (padrão: 50)\n";
+    std::cout << "  --tsplib <arquivo.tsp>       Carrega instância TSPLIB (EUC_2D, CEIL_2D, ATT, GEO, EXPLICIT)\n";
+    std::cout << "  --otimo <arquivo.opt.tour>   Rota ótima para o gap (padrão: <instância>.opt.tour, se existir)\n";
     std::cout << "  --epocas <int>               Número de gerações (padrão: 500)\n";
     std::cout << "  --pop <int>                  Tamanho da população (padrão: 200)\n";
     std::cout << "  --mut <float>                Taxa de mutação (padrão: 0.05)\n";
-    std::cout << "  --selection {torneio|roulette}  Método de seleção (padrão: torneio)\n";
+    std::cout << "  --mutacao {troca|inversao|insercao}  Operador de mutação (padrão: troca)\n";
+    std::cout << "  --crossover {ox|pmx|erx|eax}  Operador de cruzamento (padrão: ox)\n";
+    std::cout << "  --tx-cruzamento <float>      Probabilidade de cruzamento (padrão: 1.0)\n";
+    std::cout << "  --selection {torneio|roulette|ranking|sus}  Método de seleção (padrão: torneio)\n";
     std::cout << "  --torneio <int>           Tamanho do torneio (padrão: 3)\n";
+    std::cout << "  --pressao-ranking <float>    Pressão seletiva do ranking, em [1, 2] (padrão: 1.5)\n";
     std::cout << "  --alpha <int>                Contagem de alpha (padrão: 2)\n";
     std::cout << "  --paciencia <int>             Paciência para parada antecipada (padrão: 100)\n";
     std::cout << "  --seed <int>                 Semente aleatória (padrão: 42)\n";
+    std::cout << "  --threads <int>              Threads na geração de filhos (padrão: 1)\n";
+    std::cout << "  --semeadura {aleatoria|vizinho|gulosa|hilbert|mista}  População inicial (padrão: aleatoria)\n";
+    std::cout << "  --fracao-semeada <float>     Fração da população semeada por heurística (padrão: 0.5)\n";
+    std::cout << "  --busca-local {nenhuma|todos|elite|amostra}  Busca local 2-opt/Or-opt nos filhos (padrão: nenhuma)\n";
+    std::cout << "  --tx-busca-local <float>     Fração de filhos melhorados no modo amostra (padrão: 0.1)\n";
+    std::cout << "  --vizinhos <int>             Tamanho das listas de candidatos (padrão: 8)\n";
+    std::cout << "  --ilhas <int>                Número de ilhas; > 1 ativa o modelo de ilhas (padrão: 1)\n";
+    std::cout << "  --migracao <int>             Épocas entre migrações (padrão: 25)\n";
+    std::cout << "  --migrantes <int>            Melhores enviados por ilha (padrão: 2)\n";
+    std::cout << "  --topologia {anel|completa|aleatoria}  Topologia de migração (padrão: anel)\n";
+    std::cout << "  --grade-ilhas <grade>        Operadores por ilha, ex.: \"crossover=ox,eax;mut=0.02,0.1\"; a ilha i usa a\n";
+    std::cout << "                               combinação i da grade, em ciclo (padrão: todas com as opções acima)\n";
+    std::cout << "  --cache-fitness              Reaproveita a fitness de filhos idênticos a rotas da população\n";
+    std::cout << "  --duplicatas {permitir|rejeitar|mutar}  Filhos iguais a rotas da população (padrão: permitir)\n";
+    std::cout << "  --distancias {auto|densa|densa32|triangular|direta}  Backend de distâncias (padrão: auto)\n";
+    std::cout << "  --mem-distancias <int>       Orçamento da matriz de distâncias em MiB (padrão: 256)\n";
+    std::cout << "  --simd {auto|escalar|avx2|avx512}  Kernel do comprimento de rota no backend direto (padrão: auto)\n";
+    std::cout << "  --quadros {svg|gif|ambos|nenhum}  Saída dos quadros: SVGs em --frames e/ou <outdir>/evolution.gif (padrão: svg)\n";
+    std::cout << "  --checkpoint <arquivo>       Grava o estado do GA periodicamente e ao final\n";
+    std::cout << "  --checkpoint-intervalo <s>   Segundos entre checkpoints (padrão: 60)\n";
+    std::cout << "  --resume <arquivo>           Retoma de um checkpoint (mesma seed e parâmetros do GA)\n";
+    std::cout << "  --varredura <grade>          Lote de execuções, ex.: \"pop=100,200;crossover=ox,eax\"\n";
+    std::cout << "  --sementes <int>             Sementes do GA por configuração, a partir de --seed; a instância é a mesma (padrão: 1)\n";
     std::cout << "  --check                      Executar modo de validação rápida\n";
     std::cout << "  --help                       Mostrar esta mensagem de ajuda\n\n";
     std::cout << "Exemplos:\n";
     std::cout << "  " << program << " --cenario uniforme --pontos 60 --epocas 800 --mut 0.08\n";
     std::cout << "  " << program << " --cenario circulo --pontos 80 --epocas 1200 --alpha 4\n";
+    std::cout << "  " << program << " --varredura \"mut=0.02,0.05;crossover=ox,eax\" --sementes 5 --threads 8\n";
     std::cout << "  " << program << " --check\n\n";
 }
 
+bool lerArgumentos(int argc, char *argv[], Config &config);
+
 bool parseArgs(int argc, char *argv[], Config &config)
 {
     // Se não houver argumentos, perguntar se deseja usar config padrão
@@ -89,6 +206,12 @@ bool parseArgs(int argc, char *argv[], Config &config)
         }
     }
 
+    return lerArgumentos(argc, argv, config);
+}
+
+// Aplica as opções de argv[1..argc) sobre config (a última ocorrência vale)
+bool lerArgumentos(int argc, char *argv[], Config &config)
+{
     for (int i = 1; i < argc; ++i)
     {
         std::string arg = argv[i];
@@ -102,6 +225,14 @@ bool parseArgs(int argc, char *argv[], Config &config)
         {
             config.check_mode = true;
         }
+        else if (arg == "--cache-fitness")
+        {
+            config.cache_fitness = true;
+        }
+        else if (arg == "--duplicatas" && i + 1 < argc)
+        {
+            config.duplicatas = argv[++i];
+        }
         else if (arg == "--cenario" && i + 1 < argc)
         {
             config.cenario = argv[++i];
@@ -110,6 +241,14 @@ bool parseArgs(int argc, char *argv[], Config &config)
         {
             config.pontos = std::atoi(argv[++i]);
         }
+        else if (arg == "--tsplib" && i + 1 < argc)
+        {
+            config.tsplib = argv[++i];
+        }
+        else if (arg == "--otimo" && i + 1 < argc)
+        {
+            config.otimo = argv[++i];
+        }
         else if (arg == "--epocas" && i + 1 < argc)
         {
             config.epocas = std::atoi(argv[++i]);
@@ -122,6 +261,14 @@ bool parseArgs(int argc, char *argv[], Config &config)
         {
             config.tx_mutacao = std::atof(argv[++i]);
         }
+        else if (arg == "--mutacao" && i + 1 < argc)
+        {
+            config.mutacao = argv[++i];
+        }
+        else if (arg == "--tx-cruzamento" && i + 1 < argc)
+        {
+            config.tx_cruzamento = std::atof(argv[++i]);
+        }
         else if (arg == "--selection" && i + 1 < argc)
         {
             config.selection = argv[++i];
@@ -130,6 +277,10 @@ bool parseArgs(int argc, char *argv[], Config &config)
         {
             config.torneio = std::atoi(argv[++i]);
         }
+        else if (arg == "--pressao-ranking" && i + 1 < argc)
+        {
+            config.pressao_ranking = std::atof(argv[++i]);
+        }
         else if (arg == "--crossover" && i + 1 < argc)
         {
             config.crossover = argv[++i];
@@ -146,6 +297,58 @@ bool parseArgs(int argc, char *argv[], Config &config)
         {
             config.seed = std::atoi(argv[++i]);
         }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            config.threads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--semeadura" && i + 1 < argc)
+        {
+            config.semeadura = argv[++i];
+        }
+        else if (arg == "--fracao-semeada" && i + 1 < argc)
+        {
+            config.fracao_semeada = std::atof(argv[++i]);
+        }
+        else if (arg == "--busca-local" && i + 1 < argc)
+        {
+            config.busca_local = argv[++i];
+        }
+        else if (arg == "--tx-busca-local" && i + 1 < argc)
+        {
+            config.tx_busca_local = std::atof(argv[++i]);
+        }
+        else if (arg == "--vizinhos" && i + 1 < argc)
+        {
+            config.vizinhos = std::atoi(argv[++i]);
+        }
+        else if (arg == "--ilhas" && i + 1 < argc)
+        {
+            config.ilhas = std::atoi(argv[++i]);
+        }
+        else if (arg == "--migracao" && i + 1 < argc)
+        {
+            config.migracao = std::atoi(argv[++i]);
+        }
+        else if (arg == "--migrantes" && i + 1 < argc)
+        {
+            config.migrantes = std::atoi(argv[++i]);
+        }
+        else if (arg == "--topologia" && i + 1 < argc)
+        {
+            config.topologia = argv[++i];
+        }
+        else if (arg == "--distancias" && i + 1 < argc)
+        {
+            config.distancias = argv[++i];
+        }
+        else if (arg == "--mem-distancias" && i + 1 < argc)
+        {
+            config.mem_distancias = std::atoi(argv[++i]);
+        }
+        else if (arg == "--simd" && i + 1 < argc)
+        {
+            config.simd = argv[++i];
+        }
         else if (arg == "--outdir" && i + 1 < argc)
         {
             config.outdir = argv[++i];
@@ -154,6 +357,34 @@ bool parseArgs(int argc, char *argv[], Config &config)
         {
             config.framesdir = argv[++i];
         }
+        else if (arg == "--quadros" && i + 1 < argc)
+        {
+            config.quadros = argv[++i];
+        }
+        else if (arg == "--checkpoint" && i + 1 < argc)
+        {
+            config.checkpoint = argv[++i];
+        }
+        else if (arg == "--checkpoint-intervalo" && i + 1 < argc)
+        {
+            config.checkpoint_intervalo = std::atof(argv[++i]);
+        }
+        else if (arg == "--resume" && i + 1 < argc)
+        {
+            config.resume = argv[++i];
+        }
+        else if (arg == "--varredura" && i + 1 < argc)
+        {
+            config.varredura = argv[++i];
+        }
+        else if (arg == "--grade-ilhas" && i + 1 < argc)
+        {
+            config.grade_ilhas = argv[++i];
+        }
+        else if (arg == "--sementes" && i + 1 < argc)
+        {
+            config.sementes = std::atoi(argv[++i]);
+        }
         else
         {
             std::cerr << "Argumento desconhecido: " << arg << "\n";
@@ -167,7 +398,7 @@ bool parseArgs(int argc, char *argv[], Config &config)
 
 bool validarConfig(const Config &config)
 {
-    if (config.pontos < 8)
+    if (config.tsplib.empty() && config.pontos < 8)
     {
         std::cerr << "Erro: Mínimo de 8 pontos necessário\n";
         return false;
@@ -177,14 +408,119 @@ bool validarConfig(const Config &config)
         std::cerr << "Erro: Cenário deve ser 'uniforme' ou 'circulo'\n";
         return false;
     }
-    if (config.selection != "torneio" && config.selection != "roulette")
+    if (config.selection != "torneio" && config.selection != "roulette" &&
+        config.selection != "ranking" && config.selection != "sus")
+    {
+        std::cerr << "Erro: Seleção deve ser 'torneio', 'roulette', 'ranking' ou 'sus'\n";
+        return false;
+    }
+    if (config.pressao_ranking < 1.0 || config.pressao_ranking > 2.0)
+    {
+        std::cerr << "Erro: Pressão do ranking deve estar entre 1 e 2\n";
+        return false;
+    }
+    if (config.crossover != "ox" && config.crossover != "pmx" && config.crossover != "erx" &&
+        config.crossover != "eax")
+    {
+        std::cerr << "Erro: Crossover deve ser 'ox', 'pmx', 'erx' ou 'eax'\n";
+        return false;
+    }
+    if (config.mutacao != "troca" && config.mutacao != "inversao" && config.mutacao != "insercao")
+    {
+        std::cerr << "Erro: Mutação deve ser 'troca', 'inversao' ou 'insercao'\n";
+        return false;
+    }
+    if (config.tx_cruzamento < 0.0 || config.tx_cruzamento > 1.0)
+    {
+        std::cerr << "Erro: Taxa de cruzamento deve estar entre 0.0 e 1.0\n";
+        return false;
+    }
+    if (config.distancias != "auto" && config.distancias != "densa" && config.distancias != "densa32" &&
+        config.distancias != "triangular" && config.distancias != "direta")
+    {
+        std::cerr << "Erro: Distâncias deve ser 'auto', 'densa', 'densa32', 'triangular' ou 'direta'\n";
+        return false;
+    }
+    if (config.simd != "auto" && config.simd != "escalar" && config.simd != "avx2" && config.simd != "avx512")
+    {
+        std::cerr << "Erro: SIMD deve ser 'auto', 'escalar', 'avx2' ou 'avx512'\n";
+        return false;
+    }
+    if (config.threads < 1)
+    {
+        std::cerr << "Erro: Número de threads deve ser pelo menos 1\n";
+        return false;
+    }
+    if (config.semeadura != "aleatoria" && config.semeadura != "vizinho" && config.semeadura != "gulosa" &&
+        config.semeadura != "hilbert" && config.semeadura != "mista")
+    {
+        std::cerr << "Erro: Semeadura deve ser 'aleatoria', 'vizinho', 'gulosa', 'hilbert' ou 'mista'\n";
+        return false;
+    }
+    if (config.fracao_semeada < 0.0 || config.fracao_semeada > 1.0)
+    {
+        std::cerr << "Erro: Fração semeada deve estar entre 0.0 e 1.0\n";
+        return false;
+    }
+    if (config.busca_local != "nenhuma" && config.busca_local != "todos" &&
+        config.busca_local != "elite" && config.busca_local != "amostra")
+    {
+        std::cerr << "Erro: Busca local deve ser 'nenhuma', 'todos', 'elite' ou 'amostra'\n";
+        return false;
+    }
+    if (config.tx_busca_local < 0.0 || config.tx_busca_local > 1.0 || config.vizinhos < 1)
+    {
+        std::cerr << "Erro: Taxa de busca local deve estar entre 0.0 e 1.0 e vizinhos >= 1\n";
+        return false;
+    }
+    if (config.ilhas < 1 || config.migracao < 1 || config.migrantes < 0)
+    {
+        std::cerr << "Erro: Ilhas e intervalo de migração devem ser >= 1 e migrantes >= 0\n";
+        return false;
+    }
+    if (config.topologia != "anel" && config.topologia != "completa" && config.topologia != "aleatoria")
+    {
+        std::cerr << "Erro: Topologia deve ser 'anel', 'completa' ou 'aleatoria'\n";
+        return false;
+    }
+    if (config.quadros != "svg" && config.quadros != "gif" && config.quadros != "ambos" && config.quadros != "nenhum")
+    {
+        std::cerr << "Erro: Quadros deve ser 'svg', 'gif', 'ambos' ou 'nenhum'\n";
+        return false;
+    }
+    if (config.checkpoint_intervalo < 0.0)
+    {
+        std::cerr << "Erro: Intervalo de checkpoint deve ser não negativo\n";
+        return false;
+    }
+    if (config.duplicatas != "permitir" && config.duplicatas != "rejeitar" && config.duplicatas != "mutar")
+    {
+        std::cerr << "Erro: Duplicatas deve ser 'permitir', 'rejeitar' ou 'mutar'\n";
+        return false;
+    }
+    if (config.sementes < 1)
+    {
+        std::cerr << "Erro: Número de sementes deve ser >= 1\n";
+        return false;
+    }
+    if (!config.varredura.empty() && (config.ilhas > 1 || !config.checkpoint.empty() || !config.resume.empty()))
+    {
+        std::cerr << "Erro: A varredura não combina com ilhas, checkpoint ou retomada\n";
+        return false;
+    }
+    if (config.ilhas > 1 && (!config.checkpoint.empty() || !config.resume.empty()))
+    {
+        std::cerr << "Erro: Checkpoint e retomada não são suportados no modelo de ilhas\n";
+        return false;
+    }
+    if (!config.grade_ilhas.empty() && config.ilhas < 2)
     {
-        std::cerr << "Erro: Seleção deve ser 'torneio' ou 'roulette'\n";
+        std::cerr << "Erro: A grade das ilhas requer --ilhas > 1\n";
         return false;
     }
-    if (config.crossover != "ox" && config.crossover != "pmx")
+    if (config.mem_distancias < 0)
     {
-        std::cerr << "Erro: Crossover deve ser 'ox' ou 'pmx'\n";
+        std::cerr << "Erro: Orçamento de distâncias deve ser não negativo\n";
         return false;
     }
     if (config.tx_mutacao < 0.0 || config.tx_mutacao > 1.0)
@@ -195,52 +531,327 @@ bool validarConfig(const Config &config)
     return true;
 }
 
+// Converte as opções da linha de comando na configuração do GA
+GAConfig montarGAConfig(const Config &config)
+{
+    GAConfig ga_config;
+    ga_config.tam_populacao = config.pop;
+    ga_config.num_epocas = config.epocas;
+    ga_config.taxa_mutacao = config.tx_mutacao;
+    ga_config.tam_torneio = config.torneio;
+    ga_config.quant_alpha = config.alpha;
+    ga_config.paciencia = config.paciencia;
+    ga_config.seed = config.seed;
+    ga_config.taxa_cruzamento = config.tx_cruzamento;
+    ga_config.num_threads = config.threads;
+    ga_config.taxa_busca_local = config.tx_busca_local;
+    ga_config.vizinhos_busca = config.vizinhos;
+
+    ga_config.fracao_semeada = config.fracao_semeada;
+
+    // Semeadura da população inicial
+    if (config.semeadura == "vizinho")
+    {
+        ga_config.semeadura = GAConfig::VIZINHO_MAIS_PROXIMO;
+    }
+    else if (config.semeadura == "gulosa")
+    {
+        ga_config.semeadura = GAConfig::GULOSA;
+    }
+    else if (config.semeadura == "hilbert")
+    {
+        ga_config.semeadura = GAConfig::HILBERT;
+    }
+    else if (config.semeadura == "mista")
+    {
+        ga_config.semeadura = GAConfig::MISTA;
+    }
+    else
+    {
+        ga_config.semeadura = GAConfig::ALEATORIA;
+    }
+
+    // Modo memético
+    if (config.busca_local == "todos")
+    {
+        ga_config.busca_local = GAConfig::BUSCA_TODOS;
+    }
+    else if (config.busca_local == "elite")
+    {
+        ga_config.busca_local = GAConfig::BUSCA_ELITE;
+    }
+    else if (config.busca_local == "amostra")
+    {
+        ga_config.busca_local = GAConfig::BUSCA_AMOSTRA;
+    }
+    else
+    {
+        ga_config.busca_local = GAConfig::SEM_BUSCA;
+    }
+
+    // Operador de mutação
+    if (config.mutacao == "inversao")
+    {
+        ga_config.mutacao = GAConfig::INVERSAO;
+    }
+    else if (config.mutacao == "insercao")
+    {
+        ga_config.mutacao = GAConfig::INSERCAO;
+    }
+    else
+    {
+        ga_config.mutacao = GAConfig::TROCA;
+    }
+
+    // Operador de cruzamento
+    if (config.crossover == "pmx")
+    {
+        ga_config.crossover = GAConfig::PMX;
+    }
+    else if (config.crossover == "erx")
+    {
+        ga_config.crossover = GAConfig::ERX;
+    }
+    else if (config.crossover == "eax")
+    {
+        ga_config.crossover = GAConfig::EAX;
+    }
+    else
+    {
+        ga_config.crossover = GAConfig::OX;
+    }
+
+    // Método de seleção
+    if (config.selection == "torneio")
+    {
+        ga_config.selection = GAConfig::TORNEIO;
+    }
+    else if (config.selection == "ranking")
+    {
+        ga_config.selection = GAConfig::RANKING;
+    }
+    else if (config.selection == "sus")
+    {
+        ga_config.selection = GAConfig::SUS;
+    }
+    else
+    {
+        ga_config.selection = GAConfig::ROLETA;
+    }
+    ga_config.pressao_ranking = config.pressao_ranking;
+
+    // Hash de rotas: cache de fitness e política de duplicatas
+    ga_config.cache_fitness = config.cache_fitness;
+    if (config.duplicatas == "rejeitar")
+    {
+        ga_config.duplicatas = GAConfig::REJEITAR;
+    }
+    else if (config.duplicatas == "mutar")
+    {
+        ga_config.duplicatas = GAConfig::MUTAR;
+    }
+    else
+    {
+        ga_config.duplicatas = GAConfig::PERMITIR;
+    }
+
+    return ga_config;
+}
+
+// Parâmetros do GA que a varredura pode variar (os nomes das opções, sem --);
+// os que mudam a instância ou a saída são fixos no lote inteiro
+bool parametroVarredura(const std::string &chave)
+{
+    static const char *permitidos[] = {"pop", "epocas", "mut", "mutacao", "crossover", "tx-cruzamento",
+                                       "selection", "torneio", "pressao-ranking", "alpha", "paciencia",
+                                       "semeadura", "fracao-semeada", "busca-local", "tx-busca-local",
+                                       "vizinhos", "duplicatas"};
+    return std::find(std::begin(permitidos), std::end(permitidos), chave) != std::end(permitidos);
+}
+
+// Expande uma grade "chave=v1,v2;chave=v3" no produto cartesiano das
+// configurações (última dimensão varia mais rápido). Cada valor passa pelo
+// mesmo caminho das opções da linha de comando; o rótulo descreve a
+// combinação. nome identifica a grade nas mensagens de erro
+bool expandirGrade(const std::string &texto, const char *nome, const Config &base, const char *programa,
+                   std::vector<std::pair<std::string, Config>> &combinacoes)
+{
+    std::vector<std::pair<std::string, std::vector<std::string>>> dimensoes;
+    std::stringstream grade(texto);
+    std::string item;
+    while (std::getline(grade, item, ';'))
+    {
+        if (item.empty())
+            continue;
+        size_t igual = item.find('=');
+        std::string chave = item.substr(0, igual);
+        if (igual == std::string::npos || !parametroVarredura(chave))
+        {
+            std::cerr << "Erro: Parâmetro de " << nome << " inválido: '" << item << "'\n";
+            return false;
+        }
+        std::vector<std::string> valores;
+        std::stringstream lista(item.substr(igual + 1));
+        std::string valor;
+        while (std::getline(lista, valor, ','))
+        {
+            if (!valor.empty())
+                valores.push_back(valor);
+        }
+        if (valores.empty())
+        {
+            std::cerr << "Erro: Parâmetro de " << nome << " sem valores: '" << chave << "'\n";
+            return false;
+        }
+        dimensoes.emplace_back(chave, valores);
+    }
+
+    // Percorre a grade como um contador misto
+    std::vector<size_t> posicao(dimensoes.size(), 0);
+    while (true)
+    {
+        Config config = base;
+        std::string rotulo;
+        for (size_t d = 0; d < dimensoes.size(); ++d)
+        {
+            std::string opcao = "--" + dimensoes[d].first;
+            std::string valor = dimensoes[d].second[posicao[d]];
+            char *args[] = {const_cast<char *>(programa), &opcao[0], &valor[0]};
+            if (!lerArgumentos(3, args, config))
+                return false;
+            rotulo += (rotulo.empty() ? "" : " ") + dimensoes[d].first + "=" + valor;
+        }
+        if (!validarConfig(config))
+            return false;
+        combinacoes.emplace_back(rotulo.empty() ? "base" : rotulo, config);
+
+        size_t d = dimensoes.size();
+        while (d > 0 && ++posicao[d - 1] == dimensoes[d - 1].second.size())
+            posicao[--d] = 0;
+        if (d == 0)
+            break;
+    }
+    return true;
+}
+
+// Expande a grade de --varredura, cada configuração repetida para
+// --sementes sementes consecutivas
+bool montarTarefasVarredura(const Config &base, const char *programa, std::vector<TarefaVarredura> &tarefas)
+{
+    std::vector<std::pair<std::string, Config>> combinacoes;
+    if (!expandirGrade(base.varredura, "varredura", base, programa, combinacoes))
+        return false;
+    for (auto &c : combinacoes)
+    {
+        for (int s = 0; s < base.sementes; ++s)
+        {
+            c.second.seed = base.seed + s;
+            tarefas.push_back(TarefaVarredura{c.first, montarGAConfig(c.second)});
+        }
+    }
+    return true;
+}
+
+// Modo lote: roda a grade inteira sobre a instância já carregada
+int executarVarreduraCLI(const Config &config, const char *programa, const InstanciaTSP &tsp)
+{
+    std::vector<TarefaVarredura> tarefas;
+    if (!montarTarefasVarredura(config, programa, tarefas))
+        return 1;
+
+    std::cout << "Varredura: " << tarefas.size() << " execuções em " << config.threads << " thread(s)\n";
+    auto inicio = std::chrono::high_resolution_clock::now();
+    std::vector<ResultadoVarredura> resultados = executarVarredura(
+        tsp, tarefas, config.threads, [&](const ResultadoVarredura &r, int concluidas)
+        { std::cout << "[" << concluidas << "/" << tarefas.size() << "] " << r.rotulo << " seed=" << r.seed
+                    << " | Melhor: " << r.melhor << " | " << r.epocas << " épocas | "
+                    << std::fixed << std::setprecision(2) << r.tempo_s << " s\n"
+                    << std::defaultfloat << std::setprecision(6); });
+    double total = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - inicio).count();
+    std::cout << "\nVarredura concluída em " << total << " segundos\n";
+
+    std::vector<ResumoVarredura> resumos = resumirVarredura(resultados);
+    std::cout << "\n=== Resumo por configuração (melhor / média ± desvio) ===\n";
+    for (const auto &s : resumos)
+    {
+        std::cout << "  " << s.rotulo << ": " << s.melhor << " / " << s.media << " ± " << s.desvio << "\n";
+    }
+
+    std::string varredura_csv = config.outdir + "/varredura.csv";
+    std::string resumo_csv = config.outdir + "/varredura_resumo.csv";
+    if (!salvarVarreduraCSV(varredura_csv, resultados) || !salvarResumoVarreduraCSV(resumo_csv, resumos))
+    {
+        std::cerr << "Erro ao salvar resultados em " << config.outdir << "\n";
+        return 1;
+    }
+    std::cout << "\n  Salvo: " << varredura_csv << "\n";
+    std::cout << "  Salvo: " << resumo_csv << "\n";
+    return 0;
+}
+
 // GA modificado com geração de quadros
-class GAWithFrames : public GeneticAlgorithm
+template <typename Gene>
+class GAWithFrames : public GeneticAlgorithm<Gene>
 {
 private:
-    const InstanciaTSP &tsp_ref;
-    const Config &config_ref;
+    GravadorQuadros &gravador;
     int frame_interval;
 
 public:
-    GAWithFrames(const InstanciaTSP &tsp, const GAConfig &cfg, const Config &user_config)
-        : GeneticAlgorithm(tsp, cfg), tsp_ref(tsp), config_ref(user_config)
+    GAWithFrames(const InstanciaTSP &tsp, const GAConfig &cfg, GravadorQuadros &gravador_quadros)
+        : GeneticAlgorithm<Gene>(tsp, cfg), gravador(gravador_quadros)
     {
         // Salva quadros a cada N gerações (ajusta com base no total de gerações)
         frame_interval = std::max(1, cfg.num_epocas / MAXQ); // máx ~200 quadros
     }
 
-    void runWithFrames()
+    // Grava o checkpoint, avisando (sem interromper a execução) em caso de falha
+    void gravarCheckpoint(const std::string &caminho)
     {
-        initPop();
-
-        // Salva quadro inicial
-        salvarEpocaFrame(tsp_ref, melhor_todos, 0, config, config_ref.framesdir, 1);
-
-        for (int epocas = 0; epocas < config.num_epocas; ++epocas)
+        std::string erro;
+        if (!this->salvarCheckpoint(caminho, erro))
         {
-            evoluir();
+            std::cerr << "Aviso: checkpoint não gravado (" << erro << ")\n";
+        }
+    }
 
-            // Rastreia estatísticas
-            std::sort(populacao.begin(), populacao.end());
-            double melhor = populacao[0].fitness;
-            double pior = populacao.back().fitness;
-            double soma = 0.0;
-            for (const auto &ind : populacao)
+    bool runWithFrames(const Config &opcoes)
+    {
+        int inicio = 0;
+        if (!opcoes.resume.empty())
+        {
+            std::string erro;
+            if (!this->carregarCheckpoint(opcoes.resume, erro))
             {
-                soma += ind.fitness;
+                std::cerr << "Erro ao retomar de " << opcoes.resume << ": " << erro << "\n";
+                return false;
             }
-            double media = soma / populacao.size();
+            inicio = static_cast<int>(this->melhor_por_epoca.size());
+            std::cout << "Retomando na época " << inicio << " | Melhor: " << this->melhor_todos.fitness << "\n";
+        }
+        else
+        {
+            this->initPop();
+        }
+
+        // Salva quadro inicial
+        gravador.enviar(this->melhor_todos, inicio);
 
-            melhor_por_epoca.push_back(melhor);
-            media_por_epoca.push_back(media);
-            pior_por_epoca.push_back(pior);
+        // Ao retomar sem --checkpoint, continua gravando no mesmo arquivo
+        const std::string &checkpoint = opcoes.checkpoint.empty() ? opcoes.resume : opcoes.checkpoint;
+        using clock = std::chrono::steady_clock;
+        auto ultimo_checkpoint = clock::now();
+
+        for (int epocas = inicio; epocas < this->config.num_epocas; ++epocas)
+        {
+            this->passo();
+            double melhor = this->melhor_por_epoca.back();
 
             // Salva quadro em intervalos regulares
-            if ((epocas + 1) % frame_interval == 0 || epocas == config.num_epocas - 1)
+            if ((epocas + 1) % frame_interval == 0 || epocas == this->config.num_epocas - 1)
             {
-                salvarEpocaFrame(tsp_ref, melhor_todos, epocas + 1, config, config_ref.framesdir, 1);
+                PERFIL_FASE(this->perfilUltimaEpoca(), FasePerfil::QUADROS);
+                gravador.enviar(this->melhor_todos, epocas + 1);
             }
 
             // Indicador de progresso
@@ -250,135 +861,352 @@ public:
             }
 
             // Verifica paciência (parada antecipada)
-            if (generations_without_improvement >= config.paciencia)
+            if (this->pacienciaEsgotada())
             {
-                // Corta vetores para as épocas realmente executadas
-                melhor_por_epoca.resize(epocas + 1);
-                media_por_epoca.resize(epocas + 1);
-                pior_por_epoca.resize(epocas + 1);
                 std::cout << "Parada antecipada na época " << (epocas + 1) << " (paciência atingida)\n";
-                salvarEpocaFrame(tsp_ref, melhor_todos, epocas + 1, config, config_ref.framesdir, 1);
+                PERFIL_FASE(this->perfilUltimaEpoca(), FasePerfil::QUADROS);
+                gravador.enviar(this->melhor_todos, epocas + 1);
                 break;
             }
+
+            if (!checkpoint.empty() &&
+                std::chrono::duration<double>(clock::now() - ultimo_checkpoint).count() >= opcoes.checkpoint_intervalo)
+            {
+                gravarCheckpoint(checkpoint);
+                ultimo_checkpoint = clock::now();
+            }
+        }
+
+        if (!checkpoint.empty())
+        {
+            gravarCheckpoint(checkpoint);
         }
+        return true;
     }
 };
 
-int main(int argc, char *argv[])
+// Execução única ou modelo de ilhas, com o GA instanciado para o tipo de gene
+template <typename Gene>
+int executarGA(const Config &config, const char *programa, const InstanciaTSP &tsp)
 {
-    // Cria Struct com configuracoes padrões
-    Config config;
+    // Define configuração GA
+    GAConfig ga_config = montarGAConfig(config);
 
-    // caso nao seja passado argumentos na execucao do programa e o usuario opte por nao usar as configuracoes padroes, finaliza o programa
-    if (!parseArgs(argc, argv, config))
-    {
-        return 1;
-    }
-    // --check: executa com algumas modificacoes simples na config, util para debuggar ou testar o programa
-    if (config.check_mode)
+    std::cout << "Iniciando Algoritmo Genético (genes de " << 8 * sizeof(Gene) << " bits)...\n";
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Quadros são gravados em segundo plano enquanto o GA evolui
+    FormatoQuadros formato = FormatoQuadros::SVG;
+    if (config.quadros == "gif")
+        formato = FormatoQuadros::GIF;
+    else if (config.quadros == "ambos")
+        formato = FormatoQuadros::AMBOS;
+    else if (config.quadros == "nenhum")
+        formato = FormatoQuadros::NENHUM;
+    std::string animacao_gif = config.outdir + "/evolution.gif";
+    GravadorQuadros gravador(tsp, ga_config, config.framesdir, formato, animacao_gif);
+
+    std::unique_ptr<GAWithFrames<Gene>> ga;
+    std::unique_ptr<ModeloIlhas<Gene>> modelo;
+#ifdef TSP_PERFIL
+    std::vector<ContadoresFase> perfil_quadros; // quadros do modelo de ilhas, por época
+#endif
+    if (config.ilhas > 1)
     {
-        std::cout << "Executando no modo CHECK (validação rápida)\n";
-        config.epocas = 30;
-        config.pontos = 20;
-        config.pop = 50;
-    }
+        // Modelo de ilhas: sementes distintas por ilha; com --grade-ilhas, a
+        // ilha i usa a combinação i da grade (em ciclo), senão todas iguais
+        std::vector<GAConfig> configs_ilhas(config.ilhas, ga_config);
+        if (!config.grade_ilhas.empty())
+        {
+            std::vector<std::pair<std::string, Config>> combinacoes;
+            if (!expandirGrade(config.grade_ilhas, "grade das ilhas", config, programa, combinacoes))
+                return 1;
+            for (const auto &c : combinacoes)
+            {
+                if (c.second.epocas != config.epocas || c.second.paciencia != config.paciencia)
+                {
+                    std::cerr << "Erro: Épocas e paciência das ilhas vêm de --epocas e --paciencia\n";
+                    return 1;
+                }
+            }
+            for (int i = 0; i < config.ilhas; ++i)
+            {
+                const auto &c = combinacoes[i % combinacoes.size()];
+                configs_ilhas[i] = montarGAConfig(c.second);
+                std::cout << "Ilha " << i << ": " << c.first << "\n";
+            }
+        }
+        for (int i = 0; i < config.ilhas; ++i)
+        {
+            configs_ilhas[i].seed = config.seed + i;
+            configs_ilhas[i].num_threads = 1;
+        }
 
-    // valida se parametros passados para config sao validos, se nao, finaliza o programa
-    if (!validarConfig(config))
+        ConfigIlhas cfg_ilhas;
+        cfg_ilhas.num_epocas = config.epocas;
+        cfg_ilhas.intervalo_migracao = config.migracao;
+        cfg_ilhas.num_migrantes = config.migrantes;
+        cfg_ilhas.paciencia = config.paciencia;
+        cfg_ilhas.num_threads = config.threads > 1 ? config.threads : 0;
+        cfg_ilhas.seed = config.seed;
+        if (config.topologia == "completa")
+            cfg_ilhas.topologia = TopologiaMigracao::COMPLETA;
+        else if (config.topologia == "aleatoria")
+            cfg_ilhas.topologia = TopologiaMigracao::ALEATORIA;
+        else
+            cfg_ilhas.topologia = TopologiaMigracao::ANEL;
+
+        modelo = std::make_unique<ModeloIlhas<Gene>>(tsp, configs_ilhas, cfg_ilhas);
+        bool primeiro = true;
+        modelo->run([&](int epoca)
+                    {
+#ifdef TSP_PERFIL
+                        perfil_quadros.resize(epoca);
+#endif
+                        {
+                            PERFIL_FASE(perfil_quadros[epoca - 1], FasePerfil::QUADROS);
+                            if (primeiro)
+                            {
+                                gravador.enviar(modelo->getMelhorTodos(), 0);
+                                primeiro = false;
+                            }
+                            gravador.enviar(modelo->getMelhorTodos(), epoca);
+                        }
+                        std::cout << "Época " << epoca << " | Melhor global: " << modelo->getMelhorTodos().fitness << "\n"; });
+    }
+    else
     {
-        return 1;
+        // Executa GA com geração de frames em uma única execução
+        ga = std::make_unique<GAWithFrames<Gene>>(tsp, ga_config, gravador);
+        if (!ga->runWithFrames(config))
+        {
+            return 1;
+        }
     }
 
-    // printa configuracoes finais que serao utilizadas no algoritmo
-    config.print();
+    const Individual &melhor = modelo ? modelo->getMelhorTodos() : ga->getMelhorTodos();
+    const std::vector<double> &convergencia = modelo ? modelo->getMelhorGlobalPorEpoca() : ga->getMelhorPorEpoca();
 
-    // Cria diretórios de saida
-    ensureDirectories(config.outdir, config.framesdir);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
-    // Configura instância TSP
-    InstanciaTSP tsp;
-    if (config.cenario == "uniforme")
+    std::cout << "\nGA concluído em " << duration.count() / 1000.0 << " segundos\n";
+    std::cout << "Épocas executadas: " << convergencia.size() << "\n";
+    std::cout << "Melhor comprimento da rota: " << melhor.fitness << "\n";
+    if (ga && ga_config.cache_fitness)
     {
-        std::cout << "Gerando " << config.pontos << " pontos aleatórias (distribuição uniforme)...\n";
-        tsp.generateUniform(config.pontos, config.seed);
+        std::cout << "Avaliações poupadas pelo cache: " << ga->getAvaliacoesPoupadas() << "\n";
     }
-    else
+    if (ga && ga_config.duplicatas != GAConfig::PERMITIR)
     {
-        std::cout << "Gerando " << config.pontos << " pontos em um círculo...\n";
-        tsp.generateCircle(config.pontos);
+        std::cout << "Duplicatas tratadas: " << ga->getDuplicatasTratadas() << "\n";
     }
 
-    // Define configuração GA
-    GAConfig ga_config;
-    ga_config.tam_populacao = config.pop;
-    ga_config.num_epocas = config.epocas;
-    ga_config.taxa_mutacao = config.tx_mutacao;
-    ga_config.tam_torneio = config.torneio;
-    ga_config.quant_alpha = config.alpha;
-    ga_config.paciencia = config.paciencia;
-    ga_config.seed = config.seed;
-    ga_config.crossover = GAConfig::OX;
-
-    // Método de seleção
-    if (config.selection == "torneio")
+    // Gap para a rota ótima conhecida (TSPLIB)
+    std::string arquivo_otimo = config.otimo;
+    if (arquivo_otimo.empty() && !config.tsplib.empty())
     {
-        ga_config.selection = GAConfig::TORNEIO;
+        fs::path candidato = fs::path(config.tsplib).replace_extension(".opt.tour");
+        if (fs::exists(candidato))
+            arquivo_otimo = candidato.string();
     }
-    else
+    if (!arquivo_otimo.empty())
     {
-        ga_config.selection = GAConfig::ROLETA;
+        Rota rota_otima;
+        std::string erro;
+        if (carregarRotaTSPLIB(arquivo_otimo, tsp.getSize(), rota_otima, erro) && tsp.rotaValida(rota_otima))
+        {
+            double otimo = tsp.compRota(rota_otima);
+            std::cout << "Comprimento ótimo:          " << otimo << " (" << arquivo_otimo << ")\n";
+            std::cout << "Gap para o ótimo:           " << std::fixed << std::setprecision(3)
+                      << 100.0 * (melhor.fitness - otimo) / otimo << "%\n"
+                      << std::defaultfloat;
+        }
+        else
+        {
+            std::cerr << "Aviso: rota ótima ignorada (" << (erro.empty() ? "rota inválida" : erro) << ")\n";
+        }
     }
 
-    // Executa GA com geração de frames em uma única execução
-    std::cout << "Iniciando Algoritmo Genético...\n";
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    GAWithFrames ga(tsp, ga_config, config);
-    ga.runWithFrames();
-
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-
-    std::cout << "\nGA concluído em " << duration.count() / 1000.0 << " segundos\n";
-    std::cout << "Épocas executadas: " << ga.getMelhorEpocaAtual() << "\n";
-    std::cout << "Melhor comprimento da rota: " << ga.getMelhorTodos().fitness << "\n";
-
     // Salva saídas
     std::cout << "\nSalvando saídas...\n";
 
     // Melhor rota SVG
     std::string best_rota_svg = config.outdir + "/melhor_volta.svg";
-    plotRota(tsp, ga.getMelhorTodos().rota, best_rota_svg,
-             "Melhor Rota - Comprimento: " + std::to_string(ga.getMelhorTodos().fitness));
+    plotRota(tsp, melhor.rota, best_rota_svg,
+             "Melhor Rota - Comprimento: " + std::to_string(melhor.fitness));
     std::cout << "  Salvo: " << best_rota_svg << "\n";
 
     // Melhor rota texto
     std::string best_rota_txt = config.outdir + "/melhor_volta.txt";
-    salvarRotaParaFile(best_rota_txt, ga.getMelhorTodos().rota, ga.getMelhorTodos().fitness);
+    salvarRotaParaFile(best_rota_txt, melhor.rota, melhor.fitness);
     std::cout << "  Salvo: " << best_rota_txt << "\n";
 
     // Gráfico de convergência
     std::string convergencia_svg = config.outdir + "/convergencia.svg";
-    plotaConvergencia(ga.getMelhorPorEpoca(), convergencia_svg);
+    plotaConvergencia(convergencia, convergencia_svg);
     std::cout << "  Salvo: " << convergencia_svg << "\n";
 
-    // Métricas CSV
+    // Métricas CSV (no modelo de ilhas, uma série por ilha)
     std::string metricas_csv = config.outdir + "/metricas.csv";
-    salvarMetricasCSV(metricas_csv, ga.getMelhorPorEpoca(), ga.getMediaPorEpoca(),
-                      ga.getPiorPorEpoca(), config.tx_mutacao, config.seed);
+    if (modelo)
+    {
+        salvarMetricasIlhasCSV(metricas_csv, *modelo);
+    }
+    else
+    {
+        salvarMetricasCSV(metricas_csv, ga->getMelhorPorEpoca(), ga->getMediaPorEpoca(),
+                          ga->getPiorPorEpoca(), ga->getDesvioPorEpoca(), ga->getMedianaPorEpoca(),
+                          config.tx_mutacao, config.seed);
+    }
     std::cout << "  Salvo: " << metricas_csv << "\n";
 
+#ifdef TSP_PERFIL
+    // Perfil por fase (no modelo de ilhas, soma das ilhas época a época)
+    std::vector<ContadoresFase> perfil;
+    if (modelo)
+    {
+        for (int i = 0; i < modelo->getNumIlhas(); ++i)
+        {
+            const auto &p = modelo->getIlha(i).getPerfilPorEpoca();
+            perfil.resize(std::max(perfil.size(), p.size()));
+            for (size_t e = 0; e < p.size(); ++e)
+                perfil[e].somar(p[e]);
+        }
+        for (size_t e = 0; e < perfil_quadros.size() && e < perfil.size(); ++e)
+            perfil[e].somar(perfil_quadros[e]);
+    }
+    else
+    {
+        perfil = ga->getPerfilPorEpoca();
+    }
+    std::string perfil_csv = config.outdir + "/perfil.csv";
+    std::string perfil_json = config.outdir + "/perfil.json";
+    if (salvarPerfilCSV(perfil_csv, perfil) && salvarPerfilJSON(perfil_json, perfil, duration.count() / 1000.0))
+    {
+        std::cout << "  Salvo: " << perfil_csv << "\n";
+        std::cout << "  Salvo: " << perfil_json << "\n";
+    }
+    else
+    {
+        std::cerr << "Erro ao salvar o perfil em " << config.outdir << "\n";
+    }
+#endif
+
+    gravador.finalizar();
+
     std::cout << "\n=== Resumo ===\n";
-    std::cout << "Quadros salvos em: " << config.framesdir << "/\n";
+    if (gravador.gravaSVG())
+        std::cout << "Quadros salvos em: " << config.framesdir << "/\n";
+    if (gravador.gravaGIF())
+        std::cout << "Animação salva em: " << animacao_gif << "\n";
+    if (gravador.gravaSVG() || gravador.gravaGIF())
+    {
+        std::cout << "Quadros gravados:  " << gravador.getGravados();
+        if (gravador.getCombinados() > 0)
+            std::cout << " (" << gravador.getCombinados() << " combinados sob carga)";
+        std::cout << "\n";
+    }
 
     // roda modo check, para testar algoritmo, essencialmente
     if (config.check_mode)
     {
         std::cout << "\n  Modo CHECK concluído com sucesso!\n";
-        std::cout << "  - Quadros foram gerados em " << config.framesdir << "/\n";
+        if (gravador.gravaSVG())
+            std::cout << "  - Quadros foram gerados em " << config.framesdir << "/\n";
+        if (gravador.gravaGIF())
+            std::cout << "  - Animação gerada em " << animacao_gif << "\n";
         std::cout << "  - Métricas salvas em " << metricas_csv << "\n";
         std::cout << "  - Melhor rota salva em " << best_rota_svg << "\n";
     }
 
     return 0;
 }
+
+int main(int argc, char *argv[])
+{
+    // Cria Struct com configuracoes padrões
+    Config config;
+
+    // caso nao seja passado argumentos na execucao do programa e o usuario opte por nao usar as configuracoes padroes, finaliza o programa
+    if (!parseArgs(argc, argv, config))
+    {
+        return 1;
+    }
+    // --check: executa com algumas modificacoes simples na config, util para debuggar ou testar o programa
+    if (config.check_mode)
+    {
+        std::cout << "Executando no modo CHECK (validação rápida)\n";
+        config.epocas = 30;
+        config.pontos = 20;
+        config.pop = 50;
+    }
+
+    // valida se parametros passados para config sao validos, se nao, finaliza o programa
+    if (!validarConfig(config))
+    {
+        return 1;
+    }
+
+    // printa configuracoes finais que serao utilizadas no algoritmo
+    config.print();
+
+    // Cria diretórios de saida
+    ensureDirectories(config.outdir, config.framesdir);
+
+    // Configura instância TSP
+    InstanciaTSP tsp;
+    BackendDistancia backend = BackendDistancia::AUTO;
+    if (config.distancias == "densa")
+        backend = BackendDistancia::DENSA;
+    else if (config.distancias == "densa32")
+        backend = BackendDistancia::DENSA_FLOAT;
+    else if (config.distancias == "triangular")
+        backend = BackendDistancia::TRIANGULAR;
+    else if (config.distancias == "direta")
+        backend = BackendDistancia::DIRETA;
+    tsp.configurarDistancias(backend, static_cast<size_t>(config.mem_distancias) << 20);
+    if (config.simd == "escalar")
+        tsp.definirNivelSIMD(NivelSIMD::ESCALAR);
+    else if (config.simd == "avx2")
+        tsp.definirNivelSIMD(NivelSIMD::AVX2);
+    else if (config.simd == "avx512")
+        tsp.definirNivelSIMD(NivelSIMD::AVX512);
+    if (!config.tsplib.empty())
+    {
+        InfoTSPLIB info;
+        std::string erro;
+        std::cout << "Carregando instância TSPLIB " << config.tsplib << "...\n";
+        if (!carregarTSPLIB(config.tsplib, tsp, info, erro))
+        {
+            std::cerr << "Erro ao ler TSPLIB: " << erro << "\n";
+            return 1;
+        }
+        std::cout << "Instância " << info.nome << ": " << tsp.getSize() << " pontos, "
+                  << info.tipo_peso << "\n";
+    }
+    else if (config.cenario == "uniforme")
+    {
+        std::cout << "Gerando " << config.pontos << " pontos aleatórias (distribuição uniforme)...\n";
+        tsp.generateUniform(config.pontos, config.seed);
+    }
+    else
+    {
+        std::cout << "Gerando " << config.pontos << " pontos em um círculo...\n";
+        tsp.generateCircle(config.pontos);
+    }
+    std::cout << "Backend de distâncias: " << nomeBackendDistancia(tsp.getBackendDistancia());
+    if (tsp.getBackendDistancia() == BackendDistancia::DIRETA)
+        std::cout << " (kernel " << nomeNivelSIMD(tsp.getNivelSIMD()) << ")";
+    std::cout << "\n";
+
+    // Modo lote: todas as execuções compartilham a instância acima
+    if (!config.varredura.empty())
+    {
+        return executarVarreduraCLI(config, argv[0], tsp);
+    }
+
+    // O GA usa genes de 16 bits até 65535 pontos e de 32 bits acima
+    return comTipoGene(tsp.getSize(), [&](auto gene)
+                       { return executarGA<decltype(gene)>(config, argv[0], tsp); });
+}
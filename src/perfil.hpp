@@ -0,0 +1,145 @@
+#ifndef PERFIL_HPP
+#define PERFIL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+// Instrumentação por fase do laço de gerações
+// Ativada com -DTSP_PERFIL (CMake: -DTSP_PERFIL=ON; Makefile: PERFIL=1).
+// Desativada, PERFIL_FASE não gera código e os contadores nem existem nas
+// classes do GA, então o binário normal não paga nada por ela.
+
+enum class FasePerfil
+{
+    EPOCA,        // tempo de parede da época inteira (evoluir)
+    ELITISMO,     // escolha e cópia da elite
+    SELECAO,      // preparo da seleção e sorteio dos pais
+    CRUZAMENTO,
+    AVALIACAO,    // compRota dos filhos
+    MUTACAO,
+    BUSCA_LOCAL,
+    ESTATISTICAS, // estatísticas da geração e melhor de todos
+    QUADROS,      // gravação de quadros (main)
+    NUM_FASES
+};
+
+inline const char *nomeFasePerfil(int f)
+{
+    static const char *nomes[] = {"epoca", "elitismo", "selecao", "cruzamento", "avaliacao",
+                                  "mutacao", "busca_local", "estatisticas", "quadros"};
+    return nomes[f];
+}
+
+constexpr int NUM_FASES_PERFIL = static_cast<int>(FasePerfil::NUM_FASES);
+
+// Tempo (ns) e número de chamadas por fase
+// Fases executadas em paralelo somam o tempo de todas as threads
+struct ContadoresFase
+{
+    uint64_t ns[NUM_FASES_PERFIL] = {};
+    uint64_t chamadas[NUM_FASES_PERFIL] = {};
+
+    void zerar() { *this = ContadoresFase(); }
+
+    void somar(const ContadoresFase &outro)
+    {
+        for (int f = 0; f < NUM_FASES_PERFIL; ++f)
+        {
+            ns[f] += outro.ns[f];
+            chamadas[f] += outro.chamadas[f];
+        }
+    }
+};
+
+// Cronômetro de escopo: soma o tempo decorrido na fase ao sair do escopo
+class CronometroFase
+{
+private:
+    using clock = std::chrono::steady_clock;
+    ContadoresFase &contadores;
+    int fase;
+    clock::time_point inicio;
+
+public:
+    CronometroFase(ContadoresFase &c, FasePerfil f)
+        : contadores(c), fase(static_cast<int>(f)), inicio(clock::now()) {}
+
+    ~CronometroFase()
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - inicio).count();
+        contadores.ns[fase] += static_cast<uint64_t>(ns);
+        contadores.chamadas[fase] += 1;
+    }
+
+    CronometroFase(const CronometroFase &) = delete;
+    CronometroFase &operator=(const CronometroFase &) = delete;
+};
+
+#ifdef TSP_PERFIL
+#define PERFIL_CONCAT_(a, b) a##b
+#define PERFIL_CONCAT(a, b) PERFIL_CONCAT_(a, b)
+// Cronometra o restante do escopo atual na fase dada
+#define PERFIL_FASE(contadores, fase) CronometroFase PERFIL_CONCAT(cronometro_, __LINE__)((contadores), (fase))
+#else
+#define PERFIL_FASE(contadores, fase) ((void)0)
+#endif
+
+// Perfil por época em CSV: uma linha por época, ns e chamadas de cada fase
+inline bool salvarPerfilCSV(const std::string &filename, const std::vector<ContadoresFase> &por_epoca)
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << "epoca";
+    for (int f = 0; f < NUM_FASES_PERFIL; ++f)
+        file << "," << nomeFasePerfil(f) << "_ns," << nomeFasePerfil(f) << "_chamadas";
+    file << "\n";
+
+    for (size_t e = 0; e < por_epoca.size(); ++e)
+    {
+        file << e;
+        for (int f = 0; f < NUM_FASES_PERFIL; ++f)
+            file << "," << por_epoca[e].ns[f] << "," << por_epoca[e].chamadas[f];
+        file << "\n";
+    }
+    return true;
+}
+
+// Resumo da execução em JSON: totais por fase, média por chamada e fração
+// do tempo de parede das épocas
+inline bool salvarPerfilJSON(const std::string &filename, const std::vector<ContadoresFase> &por_epoca,
+                             double tempo_total_s)
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    ContadoresFase total;
+    for (const auto &c : por_epoca)
+        total.somar(c);
+    double ns_epocas = static_cast<double>(total.ns[static_cast<int>(FasePerfil::EPOCA)]);
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\n  \"epocas\": " << por_epoca.size() << ",\n";
+    file << "  \"tempo_total_s\": " << tempo_total_s << ",\n";
+    file << "  \"fases\": {\n";
+    for (int f = 0; f < NUM_FASES_PERFIL; ++f)
+    {
+        double ns = static_cast<double>(total.ns[f]);
+        uint64_t chamadas = total.chamadas[f];
+        file << "    \"" << nomeFasePerfil(f) << "\": {\"total_ms\": " << ns / 1e6
+             << ", \"chamadas\": " << chamadas
+             << ", \"ns_por_chamada\": " << (chamadas ? ns / chamadas : 0.0)
+             << ", \"fracao_epocas\": " << (ns_epocas > 0 ? ns / ns_epocas : 0.0) << "}"
+             << (f + 1 < NUM_FASES_PERFIL ? ",\n" : "\n");
+    }
+    file << "  }\n}\n";
+    return true;
+}
+
+#endif // PERFIL_HPP
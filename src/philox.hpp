@@ -0,0 +1,172 @@
+#ifndef PHILOX_HPP
+#define PHILOX_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+// Gerador baseado em contador Philox4x32-10 (Salmon et al., 2011)
+// Cada bloco de 4 números é uma função pura de (chave, contador): a chave vem
+// da semente e o contador identifica o fluxo (domínio, época, índice) e a
+// posição dentro dele. Posicionar o gerador num fluxo custa O(1), então cada
+// filho pode ter seu próprio fluxo, igual em qualquer divisão do trabalho
+// entre threads, e o estado inteiro cabe em poucos bytes.
+//
+// Satisfaz UniformRandomBitGenerator, mas inteiro(), real() e embaralhar()
+// são preferíveis às distribuições e ao std::shuffle da biblioteca padrão,
+// cujo algoritmo varia entre implementações.
+class GeradorPhilox
+{
+public:
+    using result_type = uint32_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    explicit GeradorPhilox(uint64_t semente = 0) { semear(semente); }
+
+    void semear(uint64_t semente)
+    {
+        chave[0] = static_cast<uint32_t>(semente);
+        chave[1] = static_cast<uint32_t>(semente >> 32);
+        posicionar(0, 0, 0);
+    }
+
+    // Início do fluxo (dominio, epoca, indice)
+    void posicionar(uint32_t dominio, uint32_t epoca, uint32_t indice)
+    {
+        contador[0] = 0;
+        contador[1] = indice;
+        contador[2] = epoca;
+        contador[3] = dominio;
+        usados = 4;
+    }
+
+    result_type operator()()
+    {
+        if (usados == 4)
+            proximoBloco();
+        return bloco[usados++];
+    }
+
+    // Inteiro uniforme em [0, limite) sem viés (Lemire, 2019); limite > 0
+    uint32_t abaixoDe(uint32_t limite)
+    {
+        uint64_t m = static_cast<uint64_t>((*this)()) * limite;
+        uint32_t resto = static_cast<uint32_t>(m);
+        if (resto < limite)
+        {
+            uint32_t limiar = (0u - limite) % limite;
+            while (resto < limiar)
+            {
+                m = static_cast<uint64_t>((*this)()) * limite;
+                resto = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Inteiro uniforme em [a, b]
+    int inteiro(int a, int b)
+    {
+        return a + static_cast<int>(abaixoDe(static_cast<uint32_t>(b - a) + 1));
+    }
+
+    // k inteiros em [0, limite), na mesma sequência de k chamadas a abaixoDe
+    // Consome o bloco de 4 palavras direto, com o limiar calculado uma vez
+    void inteiros(uint32_t limite, int *saida, int k)
+    {
+        uint32_t limiar = (0u - limite) % limite;
+        int i = 0;
+        while (i < k)
+        {
+            if (usados == 4)
+                proximoBloco();
+            for (; usados < 4 && i < k; ++usados)
+            {
+                uint64_t m = static_cast<uint64_t>(bloco[usados]) * limite;
+                if (static_cast<uint32_t>(m) >= limiar)
+                    saida[i++] = static_cast<int>(m >> 32);
+            }
+        }
+    }
+
+    // Real uniforme em [0, 1) com 53 bits
+    double real()
+    {
+        uint32_t alto = (*this)();
+        uint32_t baixo = (*this)();
+        return paraReal(alto, baixo);
+    }
+
+    // k reais em [0, 1), na mesma sequência de k chamadas a real()
+    // Lê o bloco direto, dois reais por bloco de 4 palavras; com um número
+    // ímpar de palavras já usadas cada real cruza blocos e vai pelo real()
+    void reais(double *saida, int k)
+    {
+        int i = 0;
+        while (i < k)
+        {
+            if (usados == 4)
+                proximoBloco();
+            if (usados & 1)
+            {
+                saida[i++] = real();
+                continue;
+            }
+            for (; usados < 4 && i < k; usados += 2)
+                saida[i++] = paraReal(bloco[usados], bloco[usados + 1]);
+        }
+    }
+
+private:
+    uint32_t chave[2];
+    uint32_t contador[4];
+    uint32_t bloco[4];
+    int usados = 4;
+
+    static double paraReal(uint64_t alto, uint64_t baixo)
+    {
+        return static_cast<double>(((alto << 32) | baixo) >> 11) * 0x1.0p-53;
+    }
+
+    static void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo)
+    {
+        uint64_t p = static_cast<uint64_t>(a) * b;
+        hi = static_cast<uint32_t>(p >> 32);
+        lo = static_cast<uint32_t>(p);
+    }
+
+    void proximoBloco()
+    {
+        uint32_t c0 = contador[0], c1 = contador[1], c2 = contador[2], c3 = contador[3];
+        uint32_t k0 = chave[0], k1 = chave[1];
+        for (int r = 0; r < 10; ++r)
+        {
+            uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(0xD2511F53u, c0, hi0, lo0);
+            mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        bloco[0] = c0;
+        bloco[1] = c1;
+        bloco[2] = c2;
+        bloco[3] = c3;
+        ++contador[0];
+        usados = 0;
+    }
+};
+
+// Fisher-Yates sobre abaixoDe: a mesma permutação em qualquer plataforma
+template <typename It>
+void embaralhar(It inicio, It fim, GeradorPhilox &rng)
+{
+    for (auto i = fim - inicio - 1; i > 0; --i)
+        std::iter_swap(inicio + i, inicio + rng.abaixoDe(static_cast<uint32_t>(i + 1)));
+}
+
+#endif // PHILOX_HPP
@@ -3,6 +3,7 @@
 
 #include "tsp.hpp"
 #include "ga.hpp"
+#include "ilhas.hpp"
 #include "third_party/plot.h"
 #include <string>
 #include <sstream>
@@ -127,6 +128,8 @@ inline bool salvarMetricasCSV(const std::string &filename,
                               const std::vector<double> &melhor,
                               const std::vector<double> &fitnessmedio,
                               const std::vector<double> &pior,
+                              const std::vector<double> &desvio,
+                              const std::vector<double> &mediana,
                               double taxa_mutacao,
                               int seed)
 {
@@ -135,7 +138,7 @@ inline bool salvarMetricasCSV(const std::string &filename,
         return false;
 
     // Cabeçalho
-    file << "epocas,melhor,fitnessmedio,pior,taxa_mutacao,seed\n";
+    file << "epocas,melhor,fitnessmedio,pior,desvio,mediana,taxa_mutacao,seed\n";
 
     // Dados
     for (size_t i = 0; i < melhor.size(); ++i)
@@ -144,6 +147,8 @@ inline bool salvarMetricasCSV(const std::string &filename,
              << std::fixed << std::setprecision(6) << melhor[i] << ","
              << fitnessmedio[i] << ","
              << pior[i] << ","
+             << desvio[i] << ","
+             << mediana[i] << ","
              << taxa_mutacao << ","
              << seed << "\n";
     }
@@ -152,6 +157,45 @@ inline bool salvarMetricasCSV(const std::string &filename,
     return true;
 }
 
+// Salva métricas do modelo de ilhas em CSV: uma série por ilha, com a
+// configuração de cada uma, mais a série "global" (melhor entre ilhas)
+template <typename Gene>
+inline bool salvarMetricasIlhasCSV(const std::string &filename, const ModeloIlhas<Gene> &modelo)
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << "ilha,epocas,melhor,fitnessmedio,pior,desvio,mediana,taxa_mutacao,seed\n";
+    file << std::fixed << std::setprecision(6);
+
+    for (int k = 0; k < modelo.getNumIlhas(); ++k)
+    {
+        const GeneticAlgorithm<Gene> &ilha = modelo.getIlha(k);
+        const auto &melhor = ilha.getMelhorPorEpoca();
+        const auto &media = ilha.getMediaPorEpoca();
+        const auto &pior = ilha.getPiorPorEpoca();
+        const auto &desvio = ilha.getDesvioPorEpoca();
+        const auto &mediana = ilha.getMedianaPorEpoca();
+        for (size_t i = 0; i < melhor.size(); ++i)
+        {
+            file << k << "," << i << ","
+                 << melhor[i] << "," << media[i] << "," << pior[i] << ","
+                 << desvio[i] << "," << mediana[i] << ","
+                 << ilha.getConfig().taxa_mutacao << "," << ilha.getConfig().seed << "\n";
+        }
+    }
+
+    const auto &global = modelo.getMelhorGlobalPorEpoca();
+    for (size_t i = 0; i < global.size(); ++i)
+    {
+        file << "global," << i << "," << global[i] << ",,,,,,\n";
+    }
+
+    file.close();
+    return true;
+}
+
 // Salva a melhor rota em arquivo de texto
 inline bool salvarRotaParaFile(const std::string &filename, const Rota &rota, double fitness)
 {
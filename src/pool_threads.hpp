@@ -0,0 +1,122 @@
+#ifndef POOL_THREADS_HPP
+#define POOL_THREADS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Pool de threads persistente para laços paralelos curtos (um por geração)
+// A thread chamadora também executa tarefas; executar() só retorna quando
+// todas as tarefas terminaram. Nenhuma alocação acontece por chamada.
+class PoolThreads
+{
+private:
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable cv_inicio;
+    std::condition_variable cv_fim;
+
+    // Tarefa corrente (type erasure sem std::function para não alocar)
+    void (*tarefa)(void *, int) = nullptr;
+    void *contexto = nullptr;
+    int num_tarefas = 0;
+    std::atomic<int> proxima{0};
+
+    int ativas = 0;         // threads auxiliares ainda trabalhando no lote
+    unsigned long lote = 0; // incrementado a cada executar()
+    bool parar = false;
+
+    void consumirTarefas()
+    {
+        int i;
+        while ((i = proxima.fetch_add(1, std::memory_order_relaxed)) < num_tarefas)
+        {
+            tarefa(contexto, i);
+        }
+    }
+
+    void laco()
+    {
+        unsigned long visto = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_inicio.wait(lock, [&]
+                               { return parar || lote != visto; });
+                if (parar)
+                    return;
+                visto = lote;
+            }
+
+            consumirTarefas();
+
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--ativas == 0)
+                cv_fim.notify_one();
+        }
+    }
+
+public:
+    // num_threads inclui a thread chamadora
+    explicit PoolThreads(int num_threads)
+    {
+        for (int i = 1; i < num_threads; ++i)
+        {
+            threads.emplace_back([this]
+                                 { laco(); });
+        }
+    }
+
+    ~PoolThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            parar = true;
+        }
+        cv_inicio.notify_all();
+        for (auto &t : threads)
+            t.join();
+    }
+
+    PoolThreads(const PoolThreads &) = delete;
+    PoolThreads &operator=(const PoolThreads &) = delete;
+
+    int tamanho() const { return static_cast<int>(threads.size()) + 1; }
+
+    // Executa fn(i) para i em [0, n) distribuindo entre as threads
+    template <typename Fn>
+    void executar(int n, Fn &&fn)
+    {
+        if (threads.empty() || n <= 1)
+        {
+            for (int i = 0; i < n; ++i)
+                fn(i);
+            return;
+        }
+
+        using F = std::remove_reference_t<Fn>;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            tarefa = [](void *ctx, int i)
+            { (*static_cast<F *>(ctx))(i); };
+            contexto = const_cast<void *>(static_cast<const void *>(&fn));
+            num_tarefas = n;
+            proxima.store(0, std::memory_order_relaxed);
+            ativas = static_cast<int>(threads.size());
+            ++lote;
+        }
+        cv_inicio.notify_all();
+
+        consumirTarefas();
+
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_fim.wait(lock, [&]
+                    { return ativas == 0; });
+    }
+};
+
+#endif // POOL_THREADS_HPP
@@ -0,0 +1,96 @@
+#ifndef SELECAO_HPP
+#define SELECAO_HPP
+
+#include "philox.hpp"
+#include <algorithm>
+#include <vector>
+
+// Tabela de alias (método de Walker/Vose) para sorteio proporcional a pesos
+// Construída em O(n) uma vez por geração; cada sorteio custa O(1).
+// Depois de construída é só leitura, então pode ser compartilhada entre threads.
+class TabelaAlias
+{
+private:
+    std::vector<double> prob;
+    std::vector<int> alias;
+    std::vector<int> pequenos, grandes; // espaço de trabalho da construção
+
+public:
+    // Pesos não negativos com soma positiva; reaproveita a capacidade dos
+    // vetores, então não aloca depois da primeira construção
+    void construir(const double *pesos, int n)
+    {
+        prob.resize(n);
+        alias.resize(n);
+        pequenos.clear();
+        grandes.clear();
+        pequenos.reserve(n);
+        grandes.reserve(n);
+
+        double total = 0.0;
+        for (int i = 0; i < n; ++i)
+            total += pesos[i];
+
+        for (int i = 0; i < n; ++i)
+        {
+            prob[i] = pesos[i] * n / total;
+            alias[i] = i;
+            if (prob[i] < 1.0)
+                pequenos.push_back(i);
+            else
+                grandes.push_back(i);
+        }
+
+        while (!pequenos.empty() && !grandes.empty())
+        {
+            int p = pequenos.back();
+            pequenos.pop_back();
+            int g = grandes.back();
+            alias[p] = g;
+            prob[g] -= 1.0 - prob[p];
+            if (prob[g] < 1.0)
+            {
+                grandes.pop_back();
+                pequenos.push_back(g);
+            }
+        }
+        // Sobras (erro de arredondamento) ficam com probabilidade 1
+        for (int i : grandes)
+            prob[i] = 1.0;
+        for (int i : pequenos)
+            prob[i] = 1.0;
+    }
+
+    int tamanho() const { return static_cast<int>(prob.size()); }
+
+    int sortear(GeradorPhilox &rng) const
+    {
+        int coluna = rng.inteiro(0, tamanho() - 1);
+        double u = rng.real();
+        return u < prob[coluna] ? coluna : alias[coluna];
+    }
+};
+
+// Amostragem universal estocástica (SUS): m índices escolhidos por m ponteiros
+// igualmente espaçados sobre a roleta, com um único número aleatório.
+// Cada índice aparece floor ou ceil de m * peso / total vezes.
+inline void amostragemUniversal(const double *pesos, int n, int m, GeradorPhilox &rng, int *saida)
+{
+    double total = 0.0;
+    for (int i = 0; i < n; ++i)
+        total += pesos[i];
+
+    double passo = total / m;
+    double ponteiro = rng.real() * passo;
+    double acumulado = pesos[0];
+    int i = 0;
+    for (int s = 0; s < m; ++s)
+    {
+        while (acumulado < ponteiro && i < n - 1)
+            acumulado += pesos[++i];
+        saida[s] = i;
+        ponteiro += passo;
+    }
+}
+
+#endif // SELECAO_HPP
@@ -0,0 +1,319 @@
+#ifndef SEMEADURA_HPP
+#define SEMEADURA_HPP
+
+#include "tsp.hpp"
+#include "indice_espacial.hpp"
+#include "philox.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// Heurísticas construtivas para semear a população inicial
+// Todas devolvem rotas válidas e usam as listas de vizinhos da instância,
+// então escalam para instâncias grandes.
+
+// Vizinho mais próximo a partir de inicio
+// Procura primeiro na lista de candidatos; se todos já foram visitados,
+// consulta uma árvore k-d dos pontos ainda livres (os visitados são removidos
+// dela). Em GEO e matriz explícita a ordem euclidiana não vale, e o recurso é
+// uma varredura dos pontos livres
+inline Rota rotaVizinhoMaisProximo(const InstanciaTSP &tsp, const ListaVizinhos &vizinhos, int inicio)
+{
+    int n = tsp.getSize();
+    Rota rota;
+    rota.reserve(n);
+
+    bool euclidiana = tsp.getMetrica() != MetricaDistancia::GEO &&
+                      tsp.getMetrica() != MetricaDistancia::EXPLICITA;
+    KDTree arvore_livres;
+    if (euclidiana)
+        arvore_livres = tsp.getIndice();
+    std::vector<int> encontrados;
+
+    // livres[0, num_livres) = pontos não visitados; pos_livre = posição inversa
+    std::vector<int> livres(n);
+    std::vector<int> pos_livre(n);
+    std::iota(livres.begin(), livres.end(), 0);
+    std::iota(pos_livre.begin(), pos_livre.end(), 0);
+    int num_livres = n;
+    auto visitar = [&](int a)
+    {
+        int p = pos_livre[a];
+        int ultimo = livres[--num_livres];
+        livres[p] = ultimo;
+        pos_livre[ultimo] = p;
+        pos_livre[a] = -1;
+        rota.push_back(a);
+        if (euclidiana)
+            arvore_livres.remover(a);
+    };
+
+    int atual = inicio;
+    visitar(atual);
+    while (num_livres > 0)
+    {
+        int proximo = -1;
+        const int *viz = vizinhos.de(atual);
+        for (int v = 0; v < vizinhos.k; ++v)
+        {
+            if (pos_livre[viz[v]] >= 0)
+            {
+                proximo = viz[v];
+                break;
+            }
+        }
+        if (proximo < 0 && euclidiana)
+        {
+            const Point &p = tsp.getPoint(atual);
+            arvore_livres.kVizinhos(p.x, p.y, 1, -1, encontrados);
+            proximo = encontrados[0];
+        }
+        else if (proximo < 0)
+        {
+            double melhor = std::numeric_limits<double>::max();
+            for (int i = 0; i < num_livres; ++i)
+            {
+                double d = tsp.dist(atual, livres[i]);
+                if (d < melhor)
+                {
+                    melhor = d;
+                    proximo = livres[i];
+                }
+            }
+        }
+        visitar(proximo);
+        atual = proximo;
+    }
+    return rota;
+}
+
+// Guloso por arestas: aceita as arestas candidatas mais curtas que não criam
+// grau 3 nem ciclo prematuro; os fragmentos restantes são ligados pela ponta
+// livre mais próxima (consultada numa árvore k-d das pontas)
+inline Rota rotaGulosa(const InstanciaTSP &tsp, const ListaVizinhos &vizinhos)
+{
+    int n = tsp.getSize();
+    if (n < 3)
+    {
+        Rota rota(n);
+        std::iota(rota.begin(), rota.end(), 0);
+        return rota;
+    }
+
+    struct Aresta
+    {
+        double d;
+        int a, b;
+        bool operator<(const Aresta &o) const
+        {
+            return d < o.d || (d == o.d && (a < o.a || (a == o.a && b < o.b)));
+        }
+    };
+    std::vector<Aresta> arestas;
+    arestas.reserve(static_cast<size_t>(n) * vizinhos.k);
+    for (int a = 0; a < n; ++a)
+    {
+        const int *viz = vizinhos.de(a);
+        for (int v = 0; v < vizinhos.k; ++v)
+        {
+            int b = viz[v];
+            // Par (a, b) com a < b aparece uma vez mesmo se for vizinho mútuo
+            bool mutuo = false;
+            const int *viz_b = vizinhos.de(b);
+            for (int w = 0; w < vizinhos.k && !mutuo; ++w)
+                mutuo = viz_b[w] == a;
+            if (a < b || !mutuo)
+                arestas.push_back({tsp.dist(a, b), std::min(a, b), std::max(a, b)});
+        }
+    }
+    std::sort(arestas.begin(), arestas.end());
+
+    // adj[2a], adj[2a+1] = vizinhos de a na solução parcial (-1 = livre)
+    std::vector<int> adj(2 * static_cast<size_t>(n), -1);
+    std::vector<int> grau(n, 0);
+    std::vector<int> pai(n);
+    std::iota(pai.begin(), pai.end(), 0);
+    auto raiz = [&](int x)
+    {
+        while (pai[x] != x)
+        {
+            pai[x] = pai[pai[x]];
+            x = pai[x];
+        }
+        return x;
+    };
+    auto ligar = [&](int a, int b)
+    {
+        adj[2 * a + grau[a]++] = b;
+        adj[2 * b + grau[b]++] = a;
+        pai[raiz(a)] = raiz(b);
+    };
+
+    int aceitas = 0;
+    for (const auto &e : arestas)
+    {
+        if (grau[e.a] < 2 && grau[e.b] < 2 && raiz(e.a) != raiz(e.b))
+        {
+            ligar(e.a, e.b);
+            if (++aceitas == n - 1)
+                break;
+        }
+    }
+
+    // Pontas livres (grau < 2): indexadas numa árvore k-d para a junção
+    std::vector<int> pontas;
+    std::vector<Point> pos_pontas;
+    for (int a = 0; a < n; ++a)
+    {
+        if (grau[a] < 2)
+        {
+            pontas.push_back(a);
+            pos_pontas.push_back(tsp.getPoint(a));
+        }
+    }
+    KDTree arvore_pontas;
+    arvore_pontas.construir(pos_pontas);
+
+    // Percorre um fragmento da ponta inicio até a outra ponta
+    auto outraPonta = [&](int inicio)
+    {
+        int anterior = -1;
+        int atual = inicio;
+        while (true)
+        {
+            int prox = adj[2 * atual] != anterior ? adj[2 * atual] : adj[2 * atual + 1];
+            if (prox < 0)
+                return atual;
+            anterior = atual;
+            atual = prox;
+        }
+    };
+
+    // Liga os fragmentos em cadeia: da ponta final de um à ponta livre mais próxima
+    int primeiro = pontas.empty() ? -1 : pontas[0];
+    int cauda = primeiro;
+    if (cauda >= 0 && grau[cauda] == 1)
+        cauda = outraPonta(cauda);
+    std::vector<int> encontrados;
+    while (aceitas < n - 1)
+    {
+        int alvo = -1;
+        for (int k = 8; alvo < 0; k *= 2)
+        {
+            int k_efetivo = std::min(k, static_cast<int>(pontas.size()));
+            arvore_pontas.kVizinhos(tsp.getPoint(cauda).x, tsp.getPoint(cauda).y, k_efetivo, -1, encontrados);
+            for (int e : encontrados)
+            {
+                int a = pontas[e];
+                if (a != cauda && grau[a] < 2 && raiz(a) != raiz(cauda))
+                {
+                    alvo = a;
+                    break;
+                }
+            }
+            if (k_efetivo == static_cast<int>(pontas.size()))
+                break;
+        }
+        int nova_cauda = grau[alvo] == 0 ? alvo : outraPonta(alvo);
+        ligar(cauda, alvo);
+        ++aceitas;
+        cauda = nova_cauda;
+    }
+
+    // Converte adjacências em rota (o ciclo se fecha entre cauda e primeiro)
+    Rota rota;
+    rota.reserve(n);
+    int anterior = -1;
+    int atual = primeiro;
+    for (int i = 0; i < n; ++i)
+    {
+        rota.push_back(atual);
+        int prox = adj[2 * atual] != anterior ? adj[2 * atual] : adj[2 * atual + 1];
+        anterior = atual;
+        atual = prox;
+    }
+    return rota;
+}
+
+// Índice na curva de Hilbert de ordem 16 para (x, y) em [0, 2^16)
+inline uint64_t indiceHilbert(uint32_t x, uint32_t y)
+{
+    const uint32_t lado = 1u << 16;
+    uint64_t d = 0;
+    for (uint32_t s = lado / 2; s > 0; s /= 2)
+    {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = lado - 1 - x;
+                y = lado - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Ordena os pontos pela curva de Hilbert: O(n log n), sem listas de vizinhos
+inline Rota rotaHilbert(const InstanciaTSP &tsp)
+{
+    const auto &pontos = tsp.getPoints();
+    int n = static_cast<int>(pontos.size());
+    Rota rota(n);
+    std::iota(rota.begin(), rota.end(), 0);
+    if (n < 3)
+        return rota;
+
+    double min_x = pontos[0].x, max_x = min_x, min_y = pontos[0].y, max_y = min_y;
+    for (const auto &p : pontos)
+    {
+        min_x = std::min(min_x, p.x);
+        max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y);
+        max_y = std::max(max_y, p.y);
+    }
+    // Mesma escala nos dois eixos para não distorcer a curva
+    double extensao = std::max(max_x - min_x, max_y - min_y);
+    double escala = extensao > 0 ? 65535.0 / extensao : 0.0;
+
+    std::vector<uint64_t> chave(n);
+    for (int i = 0; i < n; ++i)
+    {
+        auto x = static_cast<uint32_t>((pontos[i].x - min_x) * escala);
+        auto y = static_cast<uint32_t>((pontos[i].y - min_y) * escala);
+        chave[i] = indiceHilbert(x, y);
+    }
+    std::sort(rota.begin(), rota.end(), [&](int a, int b)
+              { return chave[a] < chave[b] || (chave[a] == chave[b] && a < b); });
+    return rota;
+}
+
+// Perturbação double-bridge: A B C D -> A C B D (três cortes aleatórios)
+// Usada para diversificar cópias de uma rota construída deterministicamente
+inline void perturbarDuploPonte(Rota &rota, GeradorPhilox &rng)
+{
+    int n = static_cast<int>(rota.size());
+    if (n < 8)
+    {
+        embaralhar(rota.begin(), rota.end(), rng);
+        return;
+    }
+    int cortes[3];
+    do
+    {
+        rng.inteiros(static_cast<uint32_t>(n - 1), cortes, 3);
+        for (int &c : cortes)
+            c += 1;
+        std::sort(cortes, cortes + 3);
+    } while (cortes[0] == cortes[1] || cortes[1] == cortes[2]);
+
+    std::rotate(rota.begin() + cortes[0], rota.begin() + cortes[1], rota.begin() + cortes[2]);
+}
+
+#endif // SEMEADURA_HPP
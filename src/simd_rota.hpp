@@ -0,0 +1,261 @@
+#ifndef SIMD_ROTA_HPP
+#define SIMD_ROTA_HPP
+
+#include <cmath>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TSP_SIMD_X86 1
+#endif
+
+// Comprimento de rota sobre coordenadas em estrutura de vetores (xs, ys)
+// Os kernels AVX2/AVX-512 buscam (gather) as coordenadas dos pontos da rota e
+// avaliam 8 arestas por iteração; o nível é escolhido em tempo de execução
+// conforme a CPU, com fallback escalar. Todos os níveis distribuem as arestas
+// pelas mesmas 8 somas parciais e as reduzem na mesma ordem, então o resultado
+// é idêntico bit a bit em qualquer máquina. A rota pode ter genes de 16 ou
+// 32 bits (G = uint16_t, uint32_t ou int); os índices são ampliados no gather.
+
+enum class NivelSIMD
+{
+    ESCALAR,
+    AVX2,
+    AVX512
+};
+
+// Arredondamento de cada aresta: EUCLIDIANA, EUC_2D (nint) e CEIL_2D
+enum class ArredondamentoAresta
+{
+    NENHUM,
+    PROXIMO,
+    CIMA
+};
+
+inline const char *nomeNivelSIMD(NivelSIMD nivel)
+{
+    switch (nivel)
+    {
+    case NivelSIMD::AVX512:
+        return "avx512";
+    case NivelSIMD::AVX2:
+        return "avx2";
+    default:
+        return "escalar";
+    }
+}
+
+// Maior nível suportado pela CPU (detectado uma vez)
+inline NivelSIMD nivelSIMDDisponivel()
+{
+    static const NivelSIMD nivel = []
+    {
+#ifdef TSP_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return NivelSIMD::AVX512;
+        if (__builtin_cpu_supports("avx2"))
+            return NivelSIMD::AVX2;
+#endif
+        return NivelSIMD::ESCALAR;
+    }();
+    return nivel;
+}
+
+// Nível usado por padrão: AVX2 mesmo quando há AVX-512, cujos gathers de 8
+// posições saíram mais lentos que dois de 4 nos Xeon medidos (n=20000:
+// 40 us contra 26 us por rota); AVX-512 continua disponível por escolha
+inline NivelSIMD nivelSIMDPadrao()
+{
+    return nivelSIMDDisponivel() == NivelSIMD::ESCALAR ? NivelSIMD::ESCALAR : NivelSIMD::AVX2;
+}
+
+namespace simd_rota
+{
+    constexpr int LANES = 8;
+
+    template <ArredondamentoAresta A>
+    inline double arredondar(double d)
+    {
+        if (A == ArredondamentoAresta::PROXIMO)
+            return std::floor(d + 0.5);
+        if (A == ArredondamentoAresta::CIMA)
+            return std::ceil(d);
+        return d;
+    }
+
+    template <ArredondamentoAresta A>
+    inline double aresta(const double *xs, const double *ys, int a, int b)
+    {
+        double dx = xs[a] - xs[b];
+        double dy = ys[a] - ys[b];
+        return arredondar<A>(std::sqrt(dx * dx + dy * dy));
+    }
+
+    // Redução das somas parciais e arestas que sobraram (inclusive a de
+    // fechamento), para qualquer fonte de distâncias aresta_fn(a, b)
+    template <typename G, typename Aresta>
+    inline double reduzir(const double *parciais, const G *rota, int tam, int i, Aresta aresta_fn)
+    {
+        double soma = ((parciais[0] + parciais[1]) + (parciais[2] + parciais[3])) +
+                      ((parciais[4] + parciais[5]) + (parciais[6] + parciais[7]));
+        for (; i + 1 < tam; ++i)
+            soma += aresta_fn(rota[i], rota[i + 1]);
+        return soma + aresta_fn(rota[tam - 1], rota[0]);
+    }
+
+    // Soma das arestas na ordem dos kernels: aresta i na soma parcial i % 8
+    // enquanto cabem 8 inteiras, depois a redução. As matrizes de distância
+    // também somam por aqui, então todo backend dá o mesmo comprimento
+    template <typename G, typename Aresta>
+    inline double somarEmFaixas(const G *rota, int tam, Aresta aresta_fn)
+    {
+        double parciais[LANES] = {};
+        int i = 0;
+        for (; i + LANES < tam; i += LANES)
+            for (int k = 0; k < LANES; ++k)
+                parciais[k] += aresta_fn(rota[i + k], rota[i + k + 1]);
+        return reduzir(parciais, rota, tam, i, aresta_fn);
+    }
+
+    template <ArredondamentoAresta A, typename G>
+    inline double concluir(const double *parciais, const double *xs, const double *ys,
+                           const G *rota, int tam, int i)
+    {
+        return reduzir(parciais, rota, tam, i, [xs, ys](int a, int b)
+                       { return aresta<A>(xs, ys, a, b); });
+    }
+
+    template <ArredondamentoAresta A, typename G>
+    inline double escalar(const double *xs, const double *ys, const G *rota, int tam)
+    {
+        return somarEmFaixas(rota, tam, [xs, ys](int a, int b)
+                             { return aresta<A>(xs, ys, a, b); });
+    }
+
+#ifdef TSP_SIMD_X86
+    // As variantes com máscara e origem zerada evitam o _mm*_undefined_pd dos
+    // intrínsecos simples, que gera falso aviso de não inicializado no GCC
+    __attribute__((target("avx2"))) inline __m256d buscarAVX2(const double *base, __m128i idx)
+    {
+        const __m256d todos = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, todos, 8);
+    }
+
+    __attribute__((target("avx512f"))) inline __m512d buscarAVX512(const double *base, __m256i idx)
+    {
+        return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, base, 8);
+    }
+
+    // 4 ou 8 genes consecutivos como índices de 32 bits
+    __attribute__((target("avx2"))) inline __m128i indices4(const uint16_t *r)
+    {
+        return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(r)));
+    }
+    template <typename G>
+    __attribute__((target("avx2"))) inline __m128i indices4(const G *r)
+    {
+        static_assert(sizeof(G) == 4, "gene de 32 bits");
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(r));
+    }
+    __attribute__((target("avx512f"))) inline __m256i indices8(const uint16_t *r)
+    {
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(r)));
+    }
+    template <typename G>
+    __attribute__((target("avx512f"))) inline __m256i indices8(const G *r)
+    {
+        static_assert(sizeof(G) == 4, "gene de 32 bits");
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r));
+    }
+
+    // 4 arestas: rota[i..i+3] -> rota[i+1..i+4]
+    template <ArredondamentoAresta A, typename G>
+    __attribute__((target("avx2"))) inline __m256d arestasAVX2(const double *xs, const double *ys, const G *rota)
+    {
+        __m128i a = indices4(rota);
+        __m128i b = indices4(rota + 1);
+        __m256d dx = _mm256_sub_pd(buscarAVX2(xs, a), buscarAVX2(xs, b));
+        __m256d dy = _mm256_sub_pd(buscarAVX2(ys, a), buscarAVX2(ys, b));
+        __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        if (A == ArredondamentoAresta::PROXIMO)
+            d = _mm256_floor_pd(_mm256_add_pd(d, _mm256_set1_pd(0.5)));
+        else if (A == ArredondamentoAresta::CIMA)
+            d = _mm256_ceil_pd(d);
+        return d;
+    }
+
+    template <ArredondamentoAresta A, typename G>
+    __attribute__((target("avx2"))) inline double avx2(const double *xs, const double *ys, const G *rota, int tam)
+    {
+        __m256d baixo = _mm256_setzero_pd();
+        __m256d alto = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + LANES < tam; i += LANES)
+        {
+            baixo = _mm256_add_pd(baixo, arestasAVX2<A, G>(xs, ys, rota + i));
+            alto = _mm256_add_pd(alto, arestasAVX2<A, G>(xs, ys, rota + i + 4));
+        }
+        alignas(32) double parciais[LANES];
+        _mm256_store_pd(parciais, baixo);
+        _mm256_store_pd(parciais + 4, alto);
+        return concluir<A, G>(parciais, xs, ys, rota, tam, i);
+    }
+
+    template <ArredondamentoAresta A, typename G>
+    __attribute__((target("avx512f"))) inline double avx512(const double *xs, const double *ys, const G *rota, int tam)
+    {
+        __m512d soma = _mm512_setzero_pd();
+        int i = 0;
+        for (; i + LANES < tam; i += LANES)
+        {
+            __m256i a = indices8(rota + i);
+            __m256i b = indices8(rota + i + 1);
+            __m512d dx = _mm512_sub_pd(buscarAVX512(xs, a), buscarAVX512(xs, b));
+            __m512d dy = _mm512_sub_pd(buscarAVX512(ys, a), buscarAVX512(ys, b));
+            __m512d d = _mm512_maskz_sqrt_pd(0xFF, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+            if (A == ArredondamentoAresta::PROXIMO)
+                d = _mm512_maskz_roundscale_pd(0xFF, _mm512_add_pd(d, _mm512_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            else if (A == ArredondamentoAresta::CIMA)
+                d = _mm512_maskz_roundscale_pd(0xFF, d, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+            soma = _mm512_add_pd(soma, d);
+        }
+        alignas(64) double parciais[LANES];
+        _mm512_store_pd(parciais, soma);
+        return concluir<A, G>(parciais, xs, ys, rota, tam, i);
+    }
+#endif
+
+    template <ArredondamentoAresta A, typename G>
+    inline double despachar(NivelSIMD nivel, const double *xs, const double *ys, const G *rota, int tam)
+    {
+#ifdef TSP_SIMD_X86
+        if (nivel == NivelSIMD::AVX512)
+            return avx512<A, G>(xs, ys, rota, tam);
+        if (nivel == NivelSIMD::AVX2)
+            return avx2<A, G>(xs, ys, rota, tam);
+#else
+        (void)nivel;
+#endif
+        return escalar<A, G>(xs, ys, rota, tam);
+    }
+}
+
+// Comprimento da rota cíclica de tam pontos (tam > 0)
+// nivel deve ser suportado pela CPU (ver nivelSIMDDisponivel)
+template <typename G>
+inline double comprimentoRotaSIMD(NivelSIMD nivel, ArredondamentoAresta arred,
+                                  const double *xs, const double *ys, const G *rota, int tam)
+{
+    switch (arred)
+    {
+    case ArredondamentoAresta::PROXIMO:
+        return simd_rota::despachar<ArredondamentoAresta::PROXIMO, G>(nivel, xs, ys, rota, tam);
+    case ArredondamentoAresta::CIMA:
+        return simd_rota::despachar<ArredondamentoAresta::CIMA, G>(nivel, xs, ys, rota, tam);
+    default:
+        return simd_rota::despachar<ArredondamentoAresta::NENHUM, G>(nivel, xs, ys, rota, tam);
+    }
+}
+
+#endif // SIMD_ROTA_HPP
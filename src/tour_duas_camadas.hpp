@@ -0,0 +1,348 @@
+#ifndef TOUR_DUAS_CAMADAS_HPP
+#define TOUR_DUAS_CAMADAS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Rota em lista duplamente ligada de dois níveis (Fredman et al., 1995)
+// Os pontos ficam em segmentos de ~sqrt(n) nós; cada segmento tem um bit de
+// inversão, e os segmentos formam um anel também duplamente ligado. Inverter
+// um caminho longo custa O(sqrt(n)): as pontas são separadas em segmentos
+// próprios, e os segmentos do meio só trocam de ordem e de bit.
+//
+// Cada nó guarda dois vizinhos; qual deles é o "próximo" depende do bit do
+// seu segmento. Assim, inverter um segmento não toca nos seus nós, e só as
+// duas ligações nas pontas do trecho invertido são reescritas.
+//
+// Para separar um segmento, a parte menor passa para o segmento vizinho;
+// segmentos novos só surgem quando o vizinho já tem 2*sqrt(n) nós, e a
+// estrutura é reconstruída se o número deles chega a 4x o inicial.
+//
+// Mesma interface de TourArray, com a mesma convenção: inverter() pode
+// escolher o caminho complementar, então a orientação global pode mudar.
+class TourDuasCamadas
+{
+private:
+    // Por nó
+    std::vector<int> seg;
+    std::vector<int> seq; // ordem interna no segmento (crescente com rev = 0)
+    std::vector<int> lig; // lig[2v] vizinho de seq maior, lig[2v + 1] de seq menor
+
+    // Por segmento
+    std::vector<char> rev;
+    std::vector<int> ini; // nó de menor seq
+    std::vector<int> fim; // nó de maior seq
+    std::vector<int> tam;
+    std::vector<int> seg_prox;
+    std::vector<int> seg_ant;
+    mutable std::vector<int> ordem; // posição no anel de segmentos, a partir de cabeca
+    mutable bool ordem_valida = false;
+
+    int n = 0;
+    int num_seg = 0;
+    int capacidade = 0;
+    int limite = 0; // tamanho máximo de um segmento
+    int cabeca = 0;
+
+    std::vector<int> nos; // espaço de trabalho
+    std::vector<int> aux;
+    std::vector<int> copia;
+
+    int primeiro(int s) const { return rev[s] ? fim[s] : ini[s]; }
+    int ultimo(int s) const { return rev[s] ? ini[s] : fim[s]; }
+
+    // Posição do nó no segmento, crescente no sentido next
+    int indice(int v) const { return rev[seg[v]] ? -seq[v] : seq[v]; }
+
+    void ligarProx(int v, int w) { lig[2 * v + rev[seg[v]]] = w; }
+    void ligarAnt(int v, int w) { lig[2 * v + 1 - rev[seg[v]]] = w; }
+
+    // A ordem dos segmentos só é usada por between() e é refeita sob demanda
+    void renumerar() const
+    {
+        int r = 0;
+        int s = cabeca;
+        do
+        {
+            ordem[s] = r++;
+            s = seg_prox[s];
+        } while (s != cabeca);
+        ordem_valida = true;
+    }
+
+    void reconstruir()
+    {
+        copia.resize(n);
+        salvar(copia.data());
+        carregar(copia.data(), n);
+    }
+
+    // Faz de v o primeiro nó do seu segmento. A parte menor do segmento passa
+    // para o vizinho daquele lado; vai para um segmento novo se o vizinho
+    // ficaria grande demais ou se perderia o início do segmento protegido
+    void separar(int v, int protegido)
+    {
+        int s = seg[v];
+        if (primeiro(s) == v)
+            return;
+
+        int k = indice(v) - indice(primeiro(s));
+        bool prefixo = 2 * k <= tam[s];
+        int inicio = prefixo ? primeiro(s) : v;
+        int cont = prefixo ? k : tam[s] - k;
+        int u = prev(v);
+
+        // Vizinhos lidos antes de trocar o segmento dos nós
+        nos.resize(cont);
+        aux.resize(2 * cont);
+        for (int i = 0, x = inicio; i < cont; ++i, x = next(x))
+        {
+            nos[i] = x;
+            aux[2 * i] = next(x);
+            aux[2 * i + 1] = prev(x);
+        }
+
+        int t = prefixo ? seg_ant[s] : seg_prox[s];
+        if (t == s || tam[t] + cont > limite || (prefixo ? s : t) == protegido)
+        {
+            t = num_seg++;
+            rev[t] = 0;
+            tam[t] = 0;
+            ini[t] = nos.front();
+            fim[t] = nos.back();
+            for (int i = 0; i < cont; ++i)
+                seq[nos[i]] = i;
+            int p = prefixo ? seg_ant[s] : s;
+            int q = seg_prox[p];
+            seg_prox[p] = t;
+            seg_ant[t] = p;
+            seg_prox[t] = q;
+            seg_ant[q] = t;
+        }
+        else if (prefixo)
+        {
+            // Entram depois do último nó de t
+            int base = seq[ultimo(t)];
+            int passo = rev[t] ? -1 : 1;
+            for (int i = 0; i < cont; ++i)
+                seq[nos[i]] = base + passo * (i + 1);
+            (rev[t] ? ini[t] : fim[t]) = nos.back();
+        }
+        else
+        {
+            // Entram antes do primeiro nó de t
+            int base = seq[primeiro(t)];
+            int passo = rev[t] ? -1 : 1;
+            for (int i = 0; i < cont; ++i)
+                seq[nos[i]] = base - passo * (cont - i);
+            (rev[t] ? fim[t] : ini[t]) = nos.front();
+        }
+
+        int r = rev[t];
+        for (int i = 0; i < cont; ++i)
+        {
+            int x = nos[i];
+            seg[x] = t;
+            lig[2 * x + r] = aux[2 * i];
+            lig[2 * x + 1 - r] = aux[2 * i + 1];
+        }
+        tam[t] += cont;
+        tam[s] -= cont;
+        if (prefixo)
+            (rev[s] ? fim[s] : ini[s]) = v;
+        else
+            (rev[s] ? ini[s] : fim[s]) = u;
+        ordem_valida = false;
+    }
+
+    // Inverte os segmentos de s1 até sk (sentido next), que não cobrem o anel
+    void inverterSegmentos(int s1, int sk)
+    {
+        int p_seg = seg_ant[s1];
+        int q_seg = seg_prox[sk];
+        int x1 = primeiro(s1);
+        int xk = ultimo(sk);
+        int p = prev(x1);
+        int q = next(xk);
+
+        nos.clear();
+        for (int s = s1;; s = seg_prox[s])
+        {
+            nos.push_back(s);
+            rev[s] ^= 1;
+            if (s == sk)
+                break;
+        }
+
+        int anterior = p_seg;
+        for (auto it = nos.rbegin(); it != nos.rend(); ++it)
+        {
+            seg_prox[anterior] = *it;
+            seg_ant[*it] = anterior;
+            anterior = *it;
+        }
+        seg_prox[anterior] = q_seg;
+        seg_ant[q_seg] = anterior;
+
+        ligarProx(p, xk);
+        ligarAnt(xk, p);
+        ligarProx(x1, q);
+        ligarAnt(q, x1);
+        ordem_valida = false;
+    }
+
+    // Inverte o caminho de a até b dentro de um mesmo segmento
+    // (indice(a) <= indice(b)); custa O(comprimento do caminho)
+    void inverterNoSegmento(int a, int b)
+    {
+        int s = seg[a];
+        int r = rev[s];
+        int p = prev(a);
+        int q = next(b);
+
+        nos.clear();
+        for (int x = a;; x = next(x))
+        {
+            nos.push_back(x);
+            if (x == b)
+                break;
+        }
+        int k = static_cast<int>(nos.size()) - 1;
+        for (int i = 0; i < k - i; ++i)
+            std::swap(seq[nos[i]], seq[nos[k - i]]);
+        for (int i = 0; i <= k; ++i)
+        {
+            int x = nos[i];
+            lig[2 * x + r] = i == 0 ? q : nos[i - 1];
+            lig[2 * x + 1 - r] = i == k ? p : nos[i + 1];
+        }
+        ligarProx(p, b);
+        ligarAnt(q, a);
+
+        if (ini[s] == a)
+            ini[s] = b;
+        else if (ini[s] == b)
+            ini[s] = a;
+        if (fim[s] == a)
+            fim[s] = b;
+        else if (fim[s] == b)
+            fim[s] = a;
+    }
+
+public:
+    template <typename G>
+    void carregar(const G *rota, int tam_rota)
+    {
+        n = tam_rota;
+        int g = std::max(8, static_cast<int>(std::sqrt(static_cast<double>(n))));
+        int iniciais = (n + g - 1) / g;
+        capacidade = 4 * iniciais + 2;
+        limite = 2 * g;
+
+        seg.resize(n);
+        seq.resize(n);
+        lig.resize(2 * static_cast<size_t>(n));
+        rev.assign(capacidade, 0);
+        ini.resize(capacidade);
+        fim.resize(capacidade);
+        tam.resize(capacidade);
+        seg_prox.resize(capacidade);
+        seg_ant.resize(capacidade);
+        ordem.resize(capacidade);
+        ordem_valida = false;
+
+        num_seg = iniciais;
+        cabeca = 0;
+        for (int s = 0; s < iniciais; ++s)
+        {
+            int de = s * g;
+            int ate = std::min(n, de + g);
+            ini[s] = rota[de];
+            fim[s] = rota[ate - 1];
+            tam[s] = ate - de;
+            seg_prox[s] = s + 1 == iniciais ? 0 : s + 1;
+            seg_ant[s] = s == 0 ? iniciais - 1 : s - 1;
+            for (int i = de; i < ate; ++i)
+            {
+                int v = rota[i];
+                seg[v] = s;
+                seq[v] = i - de;
+                lig[2 * v] = rota[i + 1 == n ? 0 : i + 1];
+                lig[2 * v + 1] = rota[i == 0 ? n - 1 : i - 1];
+            }
+        }
+    }
+
+    template <typename G>
+    void salvar(G *rota) const
+    {
+        int v = primeiro(cabeca);
+        for (int i = 0; i < n; ++i, v = next(v))
+            rota[i] = static_cast<G>(v);
+    }
+
+    int tamanho() const { return n; }
+    int next(int a) const { return lig[2 * a + rev[seg[a]]]; }
+    int prev(int a) const { return lig[2 * a + 1 - rev[seg[a]]]; }
+
+    // b está no caminho de a até c (sentido next, extremos inclusos)?
+    bool between(int a, int b, int c) const
+    {
+        if (!ordem_valida)
+            renumerar();
+        auto antes = [&](int x, int y)
+        {
+            int sx = ordem[seg[x]];
+            int sy = ordem[seg[y]];
+            return sx != sy ? sx < sy : indice(x) <= indice(y);
+        };
+        if (antes(a, c))
+            return antes(a, b) && antes(b, c);
+        return antes(a, b) || antes(b, c);
+    }
+
+    // Inverte o caminho de a até b (sentido next); se o caminho complementar
+    // for menor, inverte ele, o que resulta no mesmo ciclo
+    void inverter(int a, int b)
+    {
+        if (a == b || next(b) == a)
+            return;
+
+        if (seg[a] == seg[b])
+        {
+            if (indice(a) <= indice(b))
+                inverterNoSegmento(a, b);
+            else
+                inverterNoSegmento(next(b), prev(a)); // complemento dentro do segmento
+            return;
+        }
+
+        if (num_seg + 2 > capacidade)
+        {
+            reconstruir();
+            inverter(a, b);
+            return;
+        }
+
+        separar(a, -1);
+        int c = next(b);
+        separar(c, seg[a]);
+
+        int sa = seg[a];
+        int sb = seg[b];
+        int len = 0;
+        for (int s = sa; 2 * len <= n; s = seg_prox[s])
+        {
+            len += tam[s];
+            if (s == sb)
+                break;
+        }
+        if (2 * len <= n)
+            inverterSegmentos(sa, sb);
+        else
+            inverterSegmentos(seg[c], seg[prev(a)]);
+    }
+};
+
+#endif // TOUR_DUAS_CAMADAS_HPP
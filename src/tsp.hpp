@@ -5,6 +5,10 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include <cstddef>
+#include "indice_espacial.hpp"
+#include "philox.hpp"
+#include "simd_rota.hpp"
 
 // Define constante PI (compatível com C++17)
 #ifndef M_PI
@@ -23,23 +27,278 @@ struct Point
     {
         double dx = x - other.x;
         double dy = y - other.y;
-        return std::hypot(dx, dy);
+        return std::sqrt(dx * dx + dy * dy); // mesma conta dos kernels SIMD
     }
 };
 
 // Representação da rota TSP (permutação dos índices das pontos)
+// É o formato de troca (melhor rota, migrantes, quadros, arquivos); dentro do
+// GA as rotas ficam em genes de 16 ou 32 bits conforme o tamanho da instância
 using Rota = std::vector<int>;
 
+// Listas de k vizinhos mais próximos de cada ponto, em ordem crescente de
+// distância, armazenadas contiguamente (linha i = vizinhos do ponto i)
+struct ListaVizinhos
+{
+    int k = 0;
+    std::vector<int> ids;
+
+    const int *de(int i) const { return ids.data() + static_cast<size_t>(i) * k; }
+};
+
+// Backend usado para consultar distâncias entre pontos
+// DENSA:       matriz n x n em double (resultado idêntico ao cálculo direto)
+// DENSA_FLOAT: matriz n x n em float (metade da memória, perde precisão)
+// TRIANGULAR:  triângulo superior empacotado em double, n(n-1)/2 entradas
+// DIRETA:      calcula a distância a cada consulta (kernel SIMD no compRota)
+// AUTO:        escolhe o backend exato mais rápido que cabe no orçamento
+enum class BackendDistancia
+{
+    AUTO,
+    DENSA,
+    DENSA_FLOAT,
+    TRIANGULAR,
+    DIRETA
+};
+
+// Nome legível do backend (para logs)
+inline const char *nomeBackendDistancia(BackendDistancia b)
+{
+    switch (b)
+    {
+    case BackendDistancia::AUTO:
+        return "auto";
+    case BackendDistancia::DENSA:
+        return "densa";
+    case BackendDistancia::DENSA_FLOAT:
+        return "densa32";
+    case BackendDistancia::TRIANGULAR:
+        return "triangular";
+    default:
+        return "direta";
+    }
+}
+
+// Função de distância entre pontos
+// EUCLIDIANA: distância contínua (instâncias geradas)
+// EUC_2D, CEIL_2D, ATT, GEO: métricas inteiras do TSPLIB
+// EXPLICITA: matriz lida do arquivo (os pontos servem só para exibição)
+enum class MetricaDistancia
+{
+    EUCLIDIANA,
+    EUC_2D,
+    CEIL_2D,
+    ATT,
+    GEO,
+    EXPLICITA
+};
+
 // Instância TSP com pontos/pontos
 class InstanciaTSP
 {
+public:
+    // Orçamento padrão de memória para a matriz de distâncias (256 MiB)
+    static constexpr size_t ORCAMENTO_DISTANCIAS_PADRAO = size_t(256) << 20;
+
 private:
     std::vector<Point> pontos;
     int seed;
 
+    MetricaDistancia metrica = MetricaDistancia::EUCLIDIANA;
+    std::vector<Point> geo_radianos; // (latitude, longitude) em radianos, só GEO
+
+    // Coordenadas em estrutura de vetores para os kernels SIMD do compRota
+    std::vector<double> xs, ys;
+    NivelSIMD nivel_simd = nivelSIMDPadrao();
+
+    // Índice espacial dos pontos (vizinhança para heurísticas e busca local)
+    KDTree indice;
+
+    // Distâncias pré-calculadas (conteúdo depende do backend ativo)
+    BackendDistancia backend_pedido = BackendDistancia::AUTO;
+    BackendDistancia backend = BackendDistancia::DIRETA;
+    size_t orcamento_distancias = ORCAMENTO_DISTANCIAS_PADRAO;
+    std::vector<double> dist_double;
+    std::vector<float> dist_float;
+
+    // Índice no triângulo superior empacotado (requer i < j)
+    size_t indiceTriangular(size_t i, size_t j) const
+    {
+        size_t n = pontos.size();
+        return i * (2 * n - i - 1) / 2 + (j - i - 1);
+    }
+
+    // Distância pela métrica da instância, sem consultar tabelas
+    double distanciaPontos(int i, int j) const
+    {
+        const Point &a = pontos[i];
+        const Point &b = pontos[j];
+        switch (metrica)
+        {
+        case MetricaDistancia::EUC_2D:
+            return std::floor(a.distance(b) + 0.5);
+        case MetricaDistancia::CEIL_2D:
+            return std::ceil(a.distance(b));
+        case MetricaDistancia::ATT:
+        {
+            // Pseudo-euclidiana: arredonda para cima se nint(r) < r
+            double dx = a.x - b.x;
+            double dy = a.y - b.y;
+            double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+            double t = std::floor(r + 0.5);
+            return t < r ? t + 1.0 : t;
+        }
+        case MetricaDistancia::GEO:
+        {
+            if (i == j)
+                return 0.0;
+            const double RAIO_TERRA = 6378.388;
+            const Point &ga = geo_radianos[i];
+            const Point &gb = geo_radianos[j];
+            double q1 = std::cos(ga.y - gb.y);
+            double q2 = std::cos(ga.x - gb.x);
+            double q3 = std::cos(ga.x + gb.x);
+            return std::floor(RAIO_TERRA * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+        }
+        case MetricaDistancia::EXPLICITA:
+            return dist_double[static_cast<size_t>(i) * pontos.size() + j];
+        default:
+            return a.distance(b);
+        }
+    }
+
+    // Escolhe o backend exato mais rápido que cabe no orçamento
+    // (matriz explícita é sempre DENSA: ela é a própria fonte das distâncias)
+    BackendDistancia resolverBackend() const
+    {
+        if (metrica == MetricaDistancia::EXPLICITA)
+            return BackendDistancia::DENSA;
+        if (backend_pedido != BackendDistancia::AUTO)
+            return backend_pedido;
+
+        size_t n = pontos.size();
+        if (n * n * sizeof(double) <= orcamento_distancias)
+            return BackendDistancia::DENSA;
+        if (n * (n - 1) / 2 * sizeof(double) <= orcamento_distancias)
+            return BackendDistancia::TRIANGULAR;
+        return BackendDistancia::DIRETA;
+    }
+
+    // Prepara as estruturas derivadas após (re)gerar os pontos
+    void finalizarPontos()
+    {
+        xs.resize(pontos.size());
+        ys.resize(pontos.size());
+        for (size_t i = 0; i < pontos.size(); ++i)
+        {
+            xs[i] = pontos[i].x;
+            ys[i] = pontos[i].y;
+        }
+        indice.construir(pontos);
+        prepararDistancias();
+    }
+
+    // (Re)constrói as distâncias pré-calculadas para os pontos atuais
+    void prepararDistancias()
+    {
+        backend = resolverBackend();
+        if (metrica == MetricaDistancia::EXPLICITA)
+            return;
+        dist_double.clear();
+        dist_double.shrink_to_fit();
+        dist_float.clear();
+        dist_float.shrink_to_fit();
+
+        size_t n = pontos.size();
+        switch (backend)
+        {
+        case BackendDistancia::DENSA:
+            dist_double.resize(n * n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                dist_double[i * n + i] = 0.0;
+                for (size_t j = i + 1; j < n; ++j)
+                {
+                    double d = distanciaPontos(i, j);
+                    dist_double[i * n + j] = d;
+                    dist_double[j * n + i] = d;
+                }
+            }
+            break;
+        case BackendDistancia::DENSA_FLOAT:
+            dist_float.resize(n * n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                dist_float[i * n + i] = 0.0f;
+                for (size_t j = i + 1; j < n; ++j)
+                {
+                    float d = static_cast<float>(distanciaPontos(i, j));
+                    dist_float[i * n + j] = d;
+                    dist_float[j * n + i] = d;
+                }
+            }
+            break;
+        case BackendDistancia::TRIANGULAR:
+            dist_double.resize(n * (n - 1) / 2);
+            for (size_t i = 0; i < n; ++i)
+            {
+                for (size_t j = i + 1; j < n; ++j)
+                {
+                    dist_double[indiceTriangular(i, j)] = distanciaPontos(i, j);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Soma as arestas da rota cíclica usando a função de distância dada,
+    // na mesma ordem de soma dos kernels SIMD (simd_rota::somarEmFaixas)
+    template <typename G, typename Dist>
+    double somaArestas(const G *rota, size_t n, Dist dist_fn) const
+    {
+        return simd_rota::somarEmFaixas(rota, static_cast<int>(n), dist_fn);
+    }
+
+    // Métricas que o kernel SIMD calcula direto das coordenadas
+    bool arredondamentoSIMD(ArredondamentoAresta &arred) const
+    {
+        switch (metrica)
+        {
+        case MetricaDistancia::EUCLIDIANA:
+            arred = ArredondamentoAresta::NENHUM;
+            return true;
+        case MetricaDistancia::EUC_2D:
+            arred = ArredondamentoAresta::PROXIMO;
+            return true;
+        case MetricaDistancia::CEIL_2D:
+            arred = ArredondamentoAresta::CIMA;
+            return true;
+        default:
+            return false;
+        }
+    }
+
 public:
     InstanciaTSP() : seed(42) {}
 
+    // Seleciona o backend de distâncias e o orçamento de memória (em bytes)
+    // Reconstrói imediatamente se já houver pontos carregados
+    void configurarDistancias(BackendDistancia b, size_t orcamento_bytes = ORCAMENTO_DISTANCIAS_PADRAO)
+    {
+        backend_pedido = b;
+        orcamento_distancias = orcamento_bytes;
+        if (!pontos.empty())
+            prepararDistancias();
+    }
+
+    // Escolhe o kernel SIMD do compRota; nunca passa do que a CPU suporta
+    void definirNivelSIMD(NivelSIMD nivel)
+    {
+        nivel_simd = static_cast<int>(nivel) < static_cast<int>(nivelSIMDDisponivel()) ? nivel : nivelSIMDDisponivel();
+    }
+
     // Gera pontos aleatórias uniformes em [0,1] x [0,1]
     void generateUniform(int n, int random_seed)
     {
@@ -47,18 +306,21 @@ public:
         std::mt19937 rng(seed);
         std::uniform_real_distribution<double> dist(0.0, 1.0);
 
+        metrica = MetricaDistancia::EUCLIDIANA;
         pontos.clear();
         pontos.reserve(n);
         for (int i = 0; i < n; ++i)
         {
             pontos.emplace_back(dist(rng), dist(rng));
         }
+        finalizarPontos();
     }
 
     // Gera pontos em um círculo (cenário de benchmark)
     // N pontos igualmente espaçados em um círculo de raio R
     void generateCircle(int n, double radius = 1.0, double start_angle = 0.0)
     {
+        metrica = MetricaDistancia::EUCLIDIANA;
         pontos.clear();
         pontos.reserve(n);
 
@@ -69,34 +331,157 @@ public:
             double y = 0.5 + radius * std::sin(angle);
             pontos.emplace_back(x, y);
         }
+        finalizarPontos();
+    }
+
+    // Define pontos lidos de um arquivo com a métrica dada (EUC_2D, GEO...)
+    // Na métrica GEO, x e y são latitude e longitude no formato DDD.MM do TSPLIB
+    void definirPontos(std::vector<Point> pts, MetricaDistancia m)
+    {
+        metrica = m;
+        pontos = std::move(pts);
+        geo_radianos.clear();
+        if (metrica == MetricaDistancia::GEO)
+        {
+            const double PI = 3.141592; // valor fixado pelo TSPLIB
+            auto radianos = [PI](double v)
+            {
+                double graus = static_cast<int>(v);
+                return PI * (graus + 5.0 * (v - graus) / 3.0) / 180.0;
+            };
+            geo_radianos.reserve(pontos.size());
+            for (const auto &p : pontos)
+                geo_radianos.emplace_back(radianos(p.x), radianos(p.y));
+        }
+        finalizarPontos();
+    }
+
+    // Define uma matriz de distâncias explícita n x n (linha a linha, simétrica)
+    // exibicao: coordenadas para desenho; se vazia, os pontos vão num círculo
+    void definirMatriz(int n, std::vector<double> matriz, std::vector<Point> exibicao)
+    {
+        metrica = MetricaDistancia::EXPLICITA;
+        geo_radianos.clear();
+        dist_float.clear();
+        dist_float.shrink_to_fit();
+        dist_double = std::move(matriz);
+        if (static_cast<int>(exibicao.size()) == n)
+        {
+            pontos = std::move(exibicao);
+        }
+        else
+        {
+            pontos.resize(n);
+            for (int i = 0; i < n; ++i)
+            {
+                double angle = 2.0 * M_PI * i / n;
+                pontos[i] = Point(0.5 + 0.5 * std::cos(angle), 0.5 + 0.5 * std::sin(angle));
+            }
+        }
+        finalizarPontos();
+    }
+
+    // Distância entre dois pontos usando o backend ativo
+    double dist(int i, int j) const
+    {
+        size_t n = pontos.size();
+        switch (backend)
+        {
+        case BackendDistancia::DENSA:
+            return dist_double[static_cast<size_t>(i) * n + j];
+        case BackendDistancia::DENSA_FLOAT:
+            return dist_float[static_cast<size_t>(i) * n + j];
+        case BackendDistancia::TRIANGULAR:
+            if (i == j)
+                return 0.0;
+            if (i > j)
+                std::swap(i, j);
+            return dist_double[indiceTriangular(i, j)];
+        default:
+            return distanciaPontos(i, j);
+        }
     }
 
     // Calcula o comprimento total da rota (fitness)
     // A rota é cíclica: visita todas as pontos e retorna ao início
+    // O backend é resolvido uma vez por rota, não por aresta
     double compRota(const Rota &rota) const
     {
-        if (rota.empty())
+        return compRota(rota.data(), static_cast<int>(rota.size()));
+    }
+
+    // Mesmo cálculo sobre um bloco de tam genes (ex.: linha da população)
+    template <typename G>
+    double compRota(const G *rota, int tam) const
+    {
+        if (tam <= 0)
             return 0.0;
 
-        double length = 0.0;
-        for (size_t i = 0; i < rota.size(); ++i)
+        const size_t n = pontos.size();
+        switch (backend)
+        {
+        case BackendDistancia::DENSA:
+        {
+            const double *m = dist_double.data();
+            return somaArestas(rota, tam, [m, n](int a, int b)
+                               { return m[static_cast<size_t>(a) * n + b]; });
+        }
+        case BackendDistancia::DENSA_FLOAT:
+        {
+            const float *m = dist_float.data();
+            return somaArestas(rota, tam, [m, n](int a, int b)
+                               { return static_cast<double>(m[static_cast<size_t>(a) * n + b]); });
+        }
+        case BackendDistancia::TRIANGULAR:
+            return somaArestas(rota, tam, [this](int a, int b)
+                               {
+                                   if (a == b)
+                                       return 0.0;
+                                   if (a > b)
+                                       std::swap(a, b);
+                                   return dist_double[indiceTriangular(a, b)]; });
+        default:
+        {
+            ArredondamentoAresta arred;
+            if (arredondamentoSIMD(arred))
+                return comprimentoRotaSIMD(nivel_simd, arred, xs.data(), ys.data(), rota, tam);
+            return somaArestas(rota, tam, [this](int a, int b)
+                               { return distanciaPontos(a, b); });
+        }
+        }
+    }
+
+    // Avalia num rotas de tam pontos guardadas em sequência (linhas de uma
+    // população) e grava os comprimentos em saida. Atalho de conveniência:
+    // resolve métrica e kernel uma vez e chama o kernel rota a rota.
+    // Intercalar rotas por chamada não compensou (AVX2: 2 rotas empatam; 4
+    // rotas ganham 15% em n=100000 e dobram o tempo até n=10000), e os filhos
+    // de evoluir() não passam por aqui porque a mutação precisa da fitness
+    // do filho logo após o cruzamento
+    template <typename G>
+    void compRotas(const G *rotas, int tam, int num, double *saida) const
+    {
+        ArredondamentoAresta arred;
+        if (tam <= 0 || backend != BackendDistancia::DIRETA || !arredondamentoSIMD(arred))
         {
-            int from = rota[i];
-            int to = rota[(i + 1) % rota.size()]; // cyclic
-            length += pontos[from].distance(pontos[to]);
+            for (int r = 0; r < num; ++r)
+                saida[r] = compRota(rotas + static_cast<size_t>(r) * tam, tam);
+            return;
         }
-        return length;
+        for (int r = 0; r < num; ++r)
+            saida[r] = comprimentoRotaSIMD(nivel_simd, arred, xs.data(), ys.data(),
+                                           rotas + static_cast<size_t>(r) * tam, tam);
     }
 
     // Gera uma rota válida aleatória (permutação)
-    Rota randomRota(std::mt19937 &rng) const
+    Rota randomRota(GeradorPhilox &rng) const
     {
         Rota rota(pontos.size());
         for (size_t i = 0; i < pontos.size(); ++i)
         {
             rota[i] = static_cast<int>(i);
         }
-        std::shuffle(rota.begin(), rota.end(), rng);
+        embaralhar(rota.begin(), rota.end(), rng);
         return rota;
     }
 
@@ -118,11 +503,62 @@ public:
         return true;
     }
 
+    // k vizinhos mais próximos de cada ponto, via árvore k-d: O(n k log n)
+    // Em GEO e matriz explícita a ordem euclidiana das coordenadas não vale,
+    // então as listas saem de uma varredura das distâncias: O(n² log k)
+    ListaVizinhos listasVizinhos(int k) const
+    {
+        int n = static_cast<int>(pontos.size());
+        ListaVizinhos lista;
+        lista.k = std::max(0, std::min(k, n - 1));
+        lista.ids.resize(static_cast<size_t>(n) * lista.k);
+
+        if (metrica == MetricaDistancia::GEO || metrica == MetricaDistancia::EXPLICITA)
+        {
+            std::vector<int> candidatos(n > 0 ? n - 1 : 0);
+            for (int i = 0; i < n; ++i)
+            {
+                int c = 0;
+                for (int j = 0; j < n; ++j)
+                    if (j != i)
+                        candidatos[c++] = j;
+                std::partial_sort(candidatos.begin(), candidatos.begin() + lista.k, candidatos.end(),
+                                  [&](int a, int b)
+                                  {
+                                      double da = dist(i, a), db = dist(i, b);
+                                      return da < db || (da == db && a < b);
+                                  });
+                std::copy(candidatos.begin(), candidatos.begin() + lista.k,
+                          lista.ids.begin() + static_cast<size_t>(i) * lista.k);
+            }
+            return lista;
+        }
+
+        std::vector<int> encontrados;
+        for (int i = 0; i < n; ++i)
+        {
+            indice.kVizinhos(pontos[i].x, pontos[i].y, lista.k, i, encontrados);
+            std::copy(encontrados.begin(), encontrados.end(),
+                      lista.ids.begin() + static_cast<size_t>(i) * lista.k);
+        }
+        return lista;
+    }
+
+    // Pontos a distância <= raio do ponto i (incluindo o próprio i)
+    void pontosNoRaio(int i, double raio, std::vector<int> &saida) const
+    {
+        indice.noRaio(pontos[i].x, pontos[i].y, raio, saida);
+    }
+
     // Métodos de acesso
     const std::vector<Point> &getPoints() const { return pontos; }
     int getSize() const { return static_cast<int>(pontos.size()); }
     int getSeed() const { return seed; }
     const Point &getPoint(int idx) const { return pontos[idx]; }
+    BackendDistancia getBackendDistancia() const { return backend; }
+    NivelSIMD getNivelSIMD() const { return nivel_simd; }
+    MetricaDistancia getMetrica() const { return metrica; }
+    const KDTree &getIndice() const { return indice; }
 };
 
 #endif // TSP_HPP
@@ -0,0 +1,498 @@
+#ifndef TSPLIB_HPP
+#define TSPLIB_HPP
+
+#include "tsp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TSPLIB_MMAP 1
+#endif
+
+// Leitura de instâncias e rotas no formato TSPLIB
+// O arquivo é mapeado em memória e lido por um analisador próprio, sem
+// iostreams nem cópias intermediárias, o que mantém instâncias com milhões de
+// pontos abaixo de um segundo. Erros são devolvidos em texto, sem exceções.
+
+// Arquivo somente leitura mapeado em memória (ou lido inteiro, sem mmap)
+class ArquivoMapeado
+{
+private:
+    const char *dados = nullptr;
+    size_t tamanho = 0;
+#ifdef TSPLIB_MMAP
+    void *mapa = nullptr;
+#endif
+    std::vector<char> buffer;
+
+public:
+    ArquivoMapeado() = default;
+    ArquivoMapeado(const ArquivoMapeado &) = delete;
+    ArquivoMapeado &operator=(const ArquivoMapeado &) = delete;
+
+    ~ArquivoMapeado()
+    {
+#ifdef TSPLIB_MMAP
+        if (mapa)
+            munmap(mapa, tamanho);
+#endif
+    }
+
+    bool abrir(const std::string &caminho)
+    {
+#ifdef TSPLIB_MMAP
+        int fd = ::open(caminho.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        tamanho = static_cast<size_t>(st.st_size);
+        if (tamanho > 0)
+        {
+            void *m = mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED)
+            {
+                madvise(m, tamanho, MADV_SEQUENTIAL);
+                mapa = m;
+                dados = static_cast<const char *>(m);
+            }
+        }
+        ::close(fd);
+        if (dados || tamanho == 0)
+            return true;
+#endif
+        // Sem mmap: lê o arquivo inteiro de uma vez
+        std::FILE *f = std::fopen(caminho.c_str(), "rb");
+        if (!f)
+            return false;
+        std::fseek(f, 0, SEEK_END);
+        long fim = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        buffer.resize(fim > 0 ? static_cast<size_t>(fim) : 0);
+        tamanho = std::fread(buffer.data(), 1, buffer.size(), f);
+        std::fclose(f);
+        dados = buffer.data();
+        return true;
+    }
+
+    const char *inicio() const { return dados; }
+    const char *fim() const { return dados + tamanho; }
+};
+
+// Cursor sobre o texto do arquivo
+class LeitorTSPLIB
+{
+private:
+    const char *p;
+    const char *fim;
+
+    static bool espaco(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+    static bool letraChave(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+public:
+    LeitorTSPLIB(const char *inicio, const char *fim_) : p(inicio), fim(fim_) {}
+
+    bool acabou()
+    {
+        while (p < fim && espaco(*p))
+            ++p;
+        return p >= fim;
+    }
+
+    // Palavra-chave ([A-Za-z0-9_]+); vazia se o próximo caractere não for de chave
+    std::string chave()
+    {
+        acabou();
+        const char *ini = p;
+        while (p < fim && letraChave(*p))
+            ++p;
+        return std::string(ini, p);
+    }
+
+    // Valor de uma linha "CHAVE : valor", sem o ':' e sem espaços nas pontas
+    std::string valorLinha()
+    {
+        while (p < fim && (*p == ' ' || *p == '\t'))
+            ++p;
+        if (p < fim && *p == ':')
+            ++p;
+        while (p < fim && (*p == ' ' || *p == '\t'))
+            ++p;
+        const char *ini = p;
+        while (p < fim && *p != '\n')
+            ++p;
+        const char *ult = p;
+        while (ult > ini && espaco(ult[-1]))
+            --ult;
+        return std::string(ini, ult);
+    }
+
+    // Número decimal com sinal, fração e expoente opcionais
+    bool numero(double &valor)
+    {
+        if (acabou())
+            return false;
+        bool negativo = false;
+        if (*p == '-' || *p == '+')
+            negativo = *p++ == '-';
+
+        uint64_t mantissa = 0;
+        int expoente = 0;
+        int digitos = 0;
+        bool algum = false;
+        for (; p < fim && *p >= '0' && *p <= '9'; ++p, algum = true)
+        {
+            if (digitos < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa)
+                    ++digitos;
+            }
+            else
+            {
+                ++expoente;
+            }
+        }
+        if (p < fim && *p == '.')
+        {
+            for (++p; p < fim && *p >= '0' && *p <= '9'; ++p, algum = true)
+            {
+                if (digitos < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa)
+                        ++digitos;
+                    --expoente;
+                }
+            }
+        }
+        if (!algum)
+            return false;
+        if (p < fim && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            bool exp_negativo = false;
+            if (p < fim && (*p == '-' || *p == '+'))
+                exp_negativo = *p++ == '-';
+            int e = 0;
+            for (; p < fim && *p >= '0' && *p <= '9'; ++p)
+                e = std::min(e * 10 + (*p - '0'), 10000);
+            expoente += exp_negativo ? -e : e;
+        }
+
+        // Potências exatas de 10 até 1e22; além disso recorre a pow
+        static const double potencias[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        double v = static_cast<double>(mantissa);
+        if (expoente > 0)
+            v = expoente <= 22 ? v * potencias[expoente] : v * std::pow(10.0, expoente);
+        else if (expoente < 0)
+            v = -expoente <= 22 ? v / potencias[-expoente] : v * std::pow(10.0, expoente);
+        valor = negativo ? -v : v;
+        return true;
+    }
+
+    bool inteiro(long &valor)
+    {
+        double v;
+        if (!numero(v))
+            return false;
+        valor = static_cast<long>(v);
+        return true;
+    }
+};
+
+// Metadados do cabeçalho TSPLIB
+struct InfoTSPLIB
+{
+    std::string nome;
+    std::string comentario;
+    std::string tipo_peso;    // EDGE_WEIGHT_TYPE
+    std::string formato_peso; // EDGE_WEIGHT_FORMAT (só EXPLICIT)
+    int dimensao = 0;
+};
+
+// Lê "id x y" para cada um dos n pontos (ids de 1 a n, em qualquer ordem,
+// cada um uma vez)
+inline bool lerCoordenadasTSPLIB(LeitorTSPLIB &leitor, int n, std::vector<Point> &pts, std::string &erro)
+{
+    pts.assign(n, Point());
+    std::vector<char> visto(n, 0);
+    for (int k = 0; k < n; ++k)
+    {
+        long id;
+        double x, y;
+        if (!leitor.inteiro(id) || !leitor.numero(x) || !leitor.numero(y))
+        {
+            erro = "coordenadas incompletas (esperados " + std::to_string(n) + " pontos)";
+            return false;
+        }
+        if (id < 1 || id > n)
+        {
+            erro = "id de ponto fora do intervalo: " + std::to_string(id);
+            return false;
+        }
+        if (visto[id - 1])
+        {
+            erro = "id de ponto repetido: " + std::to_string(id);
+            return false;
+        }
+        visto[id - 1] = 1;
+        pts[id - 1] = Point(x, y);
+    }
+    return true;
+}
+
+// Lê os pesos de EDGE_WEIGHT_SECTION para uma matriz n x n simétrica
+// Como a matriz é simétrica, os formatos *_COL equivalem aos *_ROW opostos
+inline bool lerPesosTSPLIB(LeitorTSPLIB &leitor, int n, const std::string &formato,
+                           std::vector<double> &matriz, std::string &erro)
+{
+    matriz.assign(static_cast<size_t>(n) * n, 0.0);
+    auto definir = [&](int i, int j, double w)
+    {
+        matriz[static_cast<size_t>(i) * n + j] = w;
+        matriz[static_cast<size_t>(j) * n + i] = w;
+    };
+
+    bool superior, diagonal;
+    if (formato == "FULL_MATRIX")
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                double w;
+                if (!leitor.numero(w))
+                {
+                    erro = "matriz de pesos incompleta";
+                    return false;
+                }
+                matriz[static_cast<size_t>(i) * n + j] = w;
+            }
+        }
+        // Simetriza pelo triângulo superior (o GA assume TSP simétrico)
+        for (int i = 0; i < n; ++i)
+            for (int j = i + 1; j < n; ++j)
+                matriz[static_cast<size_t>(j) * n + i] = matriz[static_cast<size_t>(i) * n + j];
+        for (int i = 0; i < n; ++i)
+            matriz[static_cast<size_t>(i) * n + i] = 0.0;
+        return true;
+    }
+    else if (formato == "UPPER_ROW" || formato == "LOWER_COL")
+        superior = true, diagonal = false;
+    else if (formato == "LOWER_ROW" || formato == "UPPER_COL")
+        superior = false, diagonal = false;
+    else if (formato == "UPPER_DIAG_ROW" || formato == "LOWER_DIAG_COL")
+        superior = true, diagonal = true;
+    else if (formato == "LOWER_DIAG_ROW" || formato == "UPPER_DIAG_COL")
+        superior = false, diagonal = true;
+    else
+    {
+        erro = "EDGE_WEIGHT_FORMAT não suportado: " + formato;
+        return false;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        int j0 = superior ? (diagonal ? i : i + 1) : 0;
+        int j1 = superior ? n : (diagonal ? i + 1 : i);
+        for (int j = j0; j < j1; ++j)
+        {
+            double w;
+            if (!leitor.numero(w))
+            {
+                erro = "matriz de pesos incompleta";
+                return false;
+            }
+            if (i != j)
+                definir(i, j, w);
+        }
+    }
+    return true;
+}
+
+// Carrega uma instância TSP simétrica (EUC_2D, CEIL_2D, ATT, GEO ou EXPLICIT)
+inline bool carregarTSPLIB(const std::string &caminho, InstanciaTSP &tsp, InfoTSPLIB &info, std::string &erro)
+{
+    ArquivoMapeado arquivo;
+    if (!arquivo.abrir(caminho))
+    {
+        erro = "não foi possível abrir " + caminho;
+        return false;
+    }
+    LeitorTSPLIB leitor(arquivo.inicio(), arquivo.fim());
+
+    std::vector<Point> coordenadas, exibicao;
+    std::vector<double> matriz;
+    bool tem_coordenadas = false, tem_pesos = false;
+
+    while (!leitor.acabou())
+    {
+        std::string chave = leitor.chave();
+        if (chave.empty())
+        {
+            erro = "conteúdo inesperado no arquivo";
+            return false;
+        }
+        if (chave == "EOF")
+            break;
+
+        if (chave == "NODE_COORD_SECTION" || chave == "DISPLAY_DATA_SECTION")
+        {
+            if (info.dimensao <= 0)
+            {
+                erro = chave + " antes de DIMENSION";
+                return false;
+            }
+            bool coords = chave == "NODE_COORD_SECTION";
+            if (!lerCoordenadasTSPLIB(leitor, info.dimensao, coords ? coordenadas : exibicao, erro))
+                return false;
+            tem_coordenadas |= coords;
+        }
+        else if (chave == "EDGE_WEIGHT_SECTION")
+        {
+            if (info.dimensao <= 0)
+            {
+                erro = "EDGE_WEIGHT_SECTION antes de DIMENSION";
+                return false;
+            }
+            if (!lerPesosTSPLIB(leitor, info.dimensao, info.formato_peso, matriz, erro))
+                return false;
+            tem_pesos = true;
+        }
+        else if (chave == "FIXED_EDGES_SECTION" || chave == "TOUR_SECTION")
+        {
+            // Listas terminadas em -1, irrelevantes aqui
+            long v;
+            while (leitor.inteiro(v) && v != -1)
+            {
+            }
+        }
+        else
+        {
+            std::string valor = leitor.valorLinha();
+            if (chave == "NAME")
+                info.nome = valor;
+            else if (chave == "COMMENT")
+                info.comentario = valor;
+            else if (chave == "DIMENSION")
+                info.dimensao = std::atoi(valor.c_str());
+            else if (chave == "EDGE_WEIGHT_TYPE")
+                info.tipo_peso = valor;
+            else if (chave == "EDGE_WEIGHT_FORMAT")
+                info.formato_peso = valor;
+            else if (chave == "TYPE" && valor != "TSP")
+            {
+                erro = "tipo de problema não suportado: " + valor + " (apenas TSP simétrico)";
+                return false;
+            }
+        }
+    }
+
+    if (info.dimensao <= 0)
+    {
+        erro = "DIMENSION ausente ou inválida";
+        return false;
+    }
+
+    MetricaDistancia metrica;
+    if (info.tipo_peso == "EUC_2D")
+        metrica = MetricaDistancia::EUC_2D;
+    else if (info.tipo_peso == "CEIL_2D")
+        metrica = MetricaDistancia::CEIL_2D;
+    else if (info.tipo_peso == "ATT")
+        metrica = MetricaDistancia::ATT;
+    else if (info.tipo_peso == "GEO")
+        metrica = MetricaDistancia::GEO;
+    else if (info.tipo_peso == "EXPLICIT")
+        metrica = MetricaDistancia::EXPLICITA;
+    else
+    {
+        erro = "EDGE_WEIGHT_TYPE não suportado: " + info.tipo_peso;
+        return false;
+    }
+
+    if (metrica == MetricaDistancia::EXPLICITA)
+    {
+        if (!tem_pesos)
+        {
+            erro = "EDGE_WEIGHT_SECTION ausente";
+            return false;
+        }
+        tsp.definirMatriz(info.dimensao, std::move(matriz),
+                          std::move(tem_coordenadas ? coordenadas : exibicao));
+    }
+    else
+    {
+        if (!tem_coordenadas)
+        {
+            erro = "NODE_COORD_SECTION ausente";
+            return false;
+        }
+        tsp.definirPontos(std::move(coordenadas), metrica);
+    }
+    return true;
+}
+
+// Carrega uma rota .tour/.opt.tour (ids de 1 a n em TOUR_SECTION, fim em -1)
+inline bool carregarRotaTSPLIB(const std::string &caminho, int n, Rota &rota, std::string &erro)
+{
+    ArquivoMapeado arquivo;
+    if (!arquivo.abrir(caminho))
+    {
+        erro = "não foi possível abrir " + caminho;
+        return false;
+    }
+    LeitorTSPLIB leitor(arquivo.inicio(), arquivo.fim());
+
+    rota.clear();
+    while (!leitor.acabou())
+    {
+        std::string chave = leitor.chave();
+        if (chave.empty() || chave == "EOF")
+            break;
+        if (chave != "TOUR_SECTION")
+        {
+            leitor.valorLinha();
+            continue;
+        }
+        rota.reserve(n);
+        long id;
+        while (leitor.inteiro(id) && id != -1)
+        {
+            if (id < 1 || id > n)
+            {
+                erro = "id fora do intervalo na rota: " + std::to_string(id);
+                return false;
+            }
+            rota.push_back(static_cast<int>(id - 1));
+        }
+        break;
+    }
+    if (static_cast<int>(rota.size()) != n)
+    {
+        erro = "rota com " + std::to_string(rota.size()) + " pontos, esperados " + std::to_string(n);
+        return false;
+    }
+    return true;
+}
+
+#endif // TSPLIB_HPP
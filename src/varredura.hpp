@@ -0,0 +1,165 @@
+#ifndef VARREDURA_HPP
+#define VARREDURA_HPP
+
+#include "tsp.hpp"
+#include "ga.hpp"
+#include "pool_threads.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Varredura de parâmetros em lote
+// Cada tarefa é uma execução completa do GA (uma configuração e uma semente)
+// sobre a mesma instância, compartilhada só para leitura entre as threads.
+// As tarefas são distribuídas dinamicamente pelo pool, uma por thread.
+// O tipo de gene do GA é escolhido pelo tamanho da instância.
+
+struct TarefaVarredura
+{
+    std::string rotulo; // parâmetros variados, ex.: "pop=100 crossover=eax"
+    GAConfig config;
+};
+
+struct ResultadoVarredura
+{
+    int tarefa = 0;
+    std::string rotulo;
+    int seed = 0;
+    double melhor = 0.0;
+    int epocas = 0;
+    double tempo_s = 0.0;
+};
+
+// Executa as tarefas em num_threads execuções simultâneas; ao_concluir (se
+// dado) é chamado após cada tarefa, serializado, com o número de concluídas
+inline std::vector<ResultadoVarredura> executarVarredura(
+    const InstanciaTSP &tsp, const std::vector<TarefaVarredura> &tarefas, int num_threads,
+    const std::function<void(const ResultadoVarredura &, int)> &ao_concluir = nullptr)
+{
+    std::vector<ResultadoVarredura> resultados(tarefas.size());
+    std::mutex mtx;
+    int concluidas = 0;
+
+    PoolThreads pool(std::max(1, std::min(num_threads, static_cast<int>(tarefas.size()))));
+    pool.executar(static_cast<int>(tarefas.size()), [&](int i)
+                  {
+                      // O paralelismo é entre tarefas: cada GA roda numa thread só
+                      GAConfig config = tarefas[i].config;
+                      config.num_threads = 1;
+
+                      ResultadoVarredura &r = resultados[i];
+                      r.tarefa = i;
+                      r.rotulo = tarefas[i].rotulo;
+                      r.seed = config.seed;
+                      comTipoGene(tsp.getSize(), [&](auto gene)
+                                  {
+                                      auto inicio = std::chrono::steady_clock::now();
+                                      GeneticAlgorithm<decltype(gene)> ga(tsp, config);
+                                      ga.run();
+                                      r.tempo_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                                      r.melhor = ga.getMelhorTodos().fitness;
+                                      r.epocas = static_cast<int>(ga.getMelhorPorEpoca().size()); });
+
+                      if (ao_concluir)
+                      {
+                          std::lock_guard<std::mutex> lock(mtx);
+                          ao_concluir(r, ++concluidas);
+                      } });
+    return resultados;
+}
+
+// Resumo de uma configuração sobre todas as suas sementes
+struct ResumoVarredura
+{
+    std::string rotulo;
+    int execucoes = 0;
+    double melhor = std::numeric_limits<double>::max();
+    double media = 0.0;
+    double desvio = 0.0;
+    double pior = 0.0;
+    double epocas_media = 0.0;
+    double tempo_medio_s = 0.0;
+};
+
+// Agrupa por rótulo, na ordem em que as configurações aparecem
+inline std::vector<ResumoVarredura> resumirVarredura(const std::vector<ResultadoVarredura> &resultados)
+{
+    std::vector<ResumoVarredura> resumos;
+    std::map<std::string, size_t> indice;
+    std::vector<std::vector<double>> valores;
+    std::vector<double> trabalho;
+    for (const auto &r : resultados)
+    {
+        auto it = indice.find(r.rotulo);
+        if (it == indice.end())
+        {
+            it = indice.emplace(r.rotulo, resumos.size()).first;
+            resumos.emplace_back();
+            resumos.back().rotulo = r.rotulo;
+            valores.emplace_back();
+        }
+        ResumoVarredura &s = resumos[it->second];
+        s.execucoes++;
+        s.melhor = std::min(s.melhor, r.melhor);
+        s.pior = std::max(s.pior, r.melhor);
+        s.epocas_media += r.epocas;
+        s.tempo_medio_s += r.tempo_s;
+        valores[it->second].push_back(r.melhor);
+    }
+    for (size_t k = 0; k < resumos.size(); ++k)
+    {
+        ResumoVarredura &s = resumos[k];
+        EstatisticasGeracao e = calcularEstatisticas(valores[k].data(), static_cast<int>(valores[k].size()), trabalho);
+        s.media = e.media;
+        s.desvio = e.desvio;
+        s.epocas_media /= s.execucoes;
+        s.tempo_medio_s /= s.execucoes;
+    }
+    return resumos;
+}
+
+// Uma linha por tarefa
+inline bool salvarVarreduraCSV(const std::string &filename, const std::vector<ResultadoVarredura> &resultados)
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << "tarefa,configuracao,seed,melhor,epocas,tempo_s\n";
+    file << std::fixed;
+    for (const auto &r : resultados)
+    {
+        file << r.tarefa << ",\"" << r.rotulo << "\"," << r.seed << ","
+             << std::setprecision(6) << r.melhor << "," << r.epocas << ","
+             << std::setprecision(4) << r.tempo_s << "\n";
+    }
+    return true;
+}
+
+// Uma linha por configuração (estatísticas sobre as sementes)
+inline bool salvarResumoVarreduraCSV(const std::string &filename, const std::vector<ResumoVarredura> &resumos)
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << "configuracao,execucoes,melhor,media,desvio,pior,epocas_media,tempo_medio_s\n";
+    file << std::fixed;
+    for (const auto &s : resumos)
+    {
+        file << "\"" << s.rotulo << "\"," << s.execucoes << "," << std::setprecision(6)
+             << s.melhor << "," << s.media << "," << s.desvio << "," << s.pior << ","
+             << std::setprecision(1) << s.epocas_media << ","
+             << std::setprecision(4) << s.tempo_medio_s << "\n";
+    }
+    return true;
+}
+
+#endif // VARREDURA_HPP